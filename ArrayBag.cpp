@@ -5,18 +5,78 @@ CSCI 235 Spring 2024
 
 
 #include "ArrayBag.hpp"
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 
 /** default constructor**/
-template<class ItemType>
-ArrayBag<ItemType>::ArrayBag(): item_count_(0)
+template<class ItemType, class Storage, class Index>
+ArrayBag<ItemType, Storage, Index>::ArrayBag(): item_count_(0)
 {
 }  // end default constructor
 
+/** copy constructor: copies the items of a_bag **/
+template<class ItemType, class Storage, class Index>
+ArrayBag<ItemType, Storage, Index>::ArrayBag(const ArrayBag<ItemType, Storage, Index>& a_bag): item_count_(0)
+{
+	*this = a_bag;
+}  // end copy constructor
+
+/** move constructor: takes the items of a_bag, leaving it empty **/
+template<class ItemType, class Storage, class Index>
+ArrayBag<ItemType, Storage, Index>::ArrayBag(ArrayBag<ItemType, Storage, Index>&& a_bag): item_count_(0)
+{
+	*this = std::move(a_bag);
+}  // end move constructor
+
+/** @post this bag holds copies of the items of a_bag **/
+template<class ItemType, class Storage, class Index>
+ArrayBag<ItemType, Storage, Index>& ArrayBag<ItemType, Storage, Index>::operator=(const ArrayBag<ItemType, Storage, Index>& a_bag)
+{
+	if (this != &a_bag)
+	{
+		clear();
+		reserve(a_bag.item_count_);
+		for (int i = 0; i < a_bag.item_count_; i++)
+		{
+			add(a_bag.items_[i]);
+		}  // end for
+	}  // end if
+	return *this;
+}  // end copy assignment
+
+/** @post this bag holds the items of a_bag, which is left empty **/
+template<class ItemType, class Storage, class Index>
+ArrayBag<ItemType, Storage, Index>& ArrayBag<ItemType, Storage, Index>::operator=(ArrayBag<ItemType, Storage, Index>&& a_bag)
+{
+	if (this != &a_bag)
+	{
+		clear();
+		// Items keep their slots, so the index carries over as is
+		items_.moveFrom(a_bag.items_, a_bag.item_count_);
+		Index::operator=(std::move(static_cast<Index&>(a_bag)));
+		item_count_ = a_bag.item_count_;
+		a_bag.item_count_ = 0;
+		a_bag.Index::indexClear();
+	}  // end if
+	return *this;
+}  // end move assignment
+
+/** destructor: destroys every item in the bag **/
+template<class ItemType, class Storage, class Index>
+ArrayBag<ItemType, Storage, Index>::~ArrayBag()
+{
+	clear();
+}  // end destructor
+
 /**
  @return item_count_ : the current size of the bag
  **/
-template<class ItemType>
-int ArrayBag<ItemType>::getCurrentSize() const
+template<class ItemType, class Storage, class Index>
+int ArrayBag<ItemType, Storage, Index>::getCurrentSize() const
 {
 	return item_count_;
 }  // end getCurrentSize
@@ -24,60 +84,209 @@ int ArrayBag<ItemType>::getCurrentSize() const
 /**
  @return true if item_count_ == 0, false otherwise
  **/
-template<class ItemType>
-bool ArrayBag<ItemType>::isEmpty() const
+template<class ItemType, class Storage, class Index>
+bool ArrayBag<ItemType, Storage, Index>::isEmpty() const
 {
 	return item_count_ == 0;
 }  // end isEmpty
 
 /**
+ @return the number of items the bag can hold before it has to grow
+ **/
+template<class ItemType, class Storage, class Index>
+int ArrayBag<ItemType, Storage, Index>::getCapacity() const
+{
+	return items_.getCapacity();
+}  // end getCapacity
+
+/**
+ @param new_capacity the number of items the bag should be able to hold
+ @post getCapacity() >= new_capacity, if the storage policy allows it
+ @return true if the bag can now hold new_capacity items, false otherwise
+ **/
+template<class ItemType, class Storage, class Index>
+bool ArrayBag<ItemType, Storage, Index>::reserve(int new_capacity)
+{
+	return items_.reserve(new_capacity, item_count_);
+}  // end reserve
+
+/**
+ @post releases unused capacity, if the storage policy allows it
+ **/
+template<class ItemType, class Storage, class Index>
+void ArrayBag<ItemType, Storage, Index>::shrinkToFit()
+{
+	items_.shrinkToFit(item_count_);
+}  // end shrinkToFit
+
+/**
+ @return true if new_entry was successfully added to items_, false otherwise
+ **/
+template<class ItemType, class Storage, class Index>
+bool ArrayBag<ItemType, Storage, Index>::add(const ItemType& new_entry)
+{
+	return emplace(new_entry);
+}  // end add
+
+/**
+ @post new_entry is moved into items_
  @return true if new_entry was successfully added to items_, false otherwise
  **/
-template<class ItemType>
-bool ArrayBag<ItemType>::add(const ItemType& new_entry)
+template<class ItemType, class Storage, class Index>
+bool ArrayBag<ItemType, Storage, Index>::add(ItemType&& new_entry)
+{
+	return emplace(std::move(new_entry));
+}  // end add
+
+/**
+ @param args the constructor arguments of the new item
+ @post a new item is constructed in place at the end of items_
+ @return true if the item was successfully added to items_, false otherwise
+ **/
+template<class ItemType, class Storage, class Index>
+template<class... Args>
+bool ArrayBag<ItemType, Storage, Index>::emplace(Args&&... args)
 {
-	bool has_room = (item_count_ < DEFAULT_CAPACITY);
-	if (has_room)
+	items_.makeUnique(item_count_);
+	if (item_count_ < items_.getCapacity())
+	{
+		::new (static_cast<void*>(items_.data() + item_count_)) ItemType(std::forward<Args>(args)...);
+	}
+	else
 	{
-		items_[item_count_] = new_entry;
-		item_count_++;
-        return true;
+		// args may refer to an item in this bag, so build the new item before growing moves them
+		ItemType new_entry(std::forward<Args>(args)...);
+		bool has_room = items_.makeRoom(item_count_);
+		if (!has_room)
+		{
+			return false;
+		}  // end if
+		::new (static_cast<void*>(items_.data() + item_count_)) ItemType(std::move(new_entry));
 	}  // end if
 
-	return false;
-}  // end add
+	Index::indexAdd(items_[item_count_], item_count_);
+	item_count_++;
+	return true;
+}  // end emplace
 
 /**
  @return true if an_entry was successfully removed from items_, false otherwise
  **/
-template<class ItemType>
-bool ArrayBag<ItemType>::remove(const ItemType& an_entry)
+template<class ItemType, class Storage, class Index>
+bool ArrayBag<ItemType, Storage, Index>::remove(const ItemType& an_entry)
 {
-   int found_index = getIndexOf(an_entry);
-	bool can_remove = !isEmpty() && (found_index > -1);
+	return eraseAt(getIndexOf(an_entry));
+}  // end remove
+
+/**
+ @param index the slot of the item to remove
+ @post the last item is moved into slot index, and the last slot is destroyed. O(1)
+ @return true if 0 <= index < item_count_ and the item was removed, false otherwise
+ **/
+template<class ItemType, class Storage, class Index>
+bool ArrayBag<ItemType, Storage, Index>::eraseAt(int index)
+{
+	bool can_remove = (index >= 0) && (index < item_count_);
 	if (can_remove)
 	{
+		items_.makeUnique(item_count_);
 		item_count_--;
-		items_[found_index] = items_[item_count_];
+		Index::indexErase(items_[index], index);
+		if (index != item_count_)
+		{
+			// Fill the hole with the last item
+			Index::indexMove(items_[item_count_], item_count_, index);
+			items_[index] = std::move(items_[item_count_]);
+		}  // end if
+		std::destroy_at(items_.data() + item_count_);
 	}  // end if
 	return can_remove;
-}  // end remove
+}  // end eraseAt
+
+/**
+ @param pred called once on each item, in order, returning true for items to remove
+ @post every item for which pred returned true is removed in a single pass;
+       the remaining items keep their relative order. If pred throws, the items it
+       had already picked are removed, the rest are kept, and the exception is rethrown
+ @return the number of items removed
+ **/
+template<class ItemType, class Storage, class Index>
+template<class Predicate>
+int ArrayBag<ItemType, Storage, Index>::removeIf(Predicate pred)
+{
+	items_.makeUnique(item_count_);
+
+	// Kept items are compacted down to [0, kept)
+	int kept = 0;
+	auto keep = [&](int i)
+	{
+		if (kept != i)
+		{
+			Index::indexMove(items_[i], i, kept);
+			items_[kept] = std::move(items_[i]);
+		}  // end if
+		kept++;
+	};
+
+	int i = 0;
+	try
+	{
+		for (; i < item_count_; i++)
+		{
+			if (pred(items_[i]))
+			{
+				Index::indexErase(items_[i], i);
+			}
+			else
+			{
+				keep(i);
+			}  // end if
+		}  // end for
+	}
+	catch (...)
+	{
+		// Finish compacting so the index matches the slots again
+		for (; i < item_count_; i++)
+		{
+			keep(i);
+		}  // end for
+		std::destroy(items_.data() + kept, items_.data() + item_count_);
+		item_count_ = kept;
+		throw;
+	}  // end try
+
+	int removed = item_count_ - kept;
+	std::destroy(items_.data() + kept, items_.data() + item_count_);
+	item_count_ = kept;
+	return removed;
+}  // end removeIf
 
 /**
  @post item_count_ == 0
  **/
-template<class ItemType>
-void ArrayBag<ItemType>::clear()
+template<class ItemType, class Storage, class Index>
+void ArrayBag<ItemType, Storage, Index>::clear()
 {
+	items_.clear(item_count_);
 	item_count_ = 0;
+	Index::indexClear();
 }  // end clear
 
 /**
  @return the number of times an_entry is found in items_
  **/
-template<class ItemType>
-int ArrayBag<ItemType>::getFrequencyOf(const ItemType& an_entry) const
+template<class ItemType, class Storage, class Index>
+int ArrayBag<ItemType, Storage, Index>::getFrequencyOf(const ItemType& an_entry) const
 {
+   if constexpr (Index::INDEXED)
+   {
+      return Index::indexCount(an_entry);
+   }
+   else if constexpr (IsScannable<ItemType>::value)
+   {
+      return scanCount(items_.data(), item_count_, an_entry);
+   }  // end if
+
    int frequency = 0;
    int curr_index = 0;       // Current array index
    while (curr_index < item_count_)
@@ -96,12 +305,77 @@ int ArrayBag<ItemType>::getFrequencyOf(const ItemType& an_entry) const
 /**
  @return true if an_entry is found in items_, false otherwise
  **/
-template<class ItemType>
-bool ArrayBag<ItemType>::contains(const ItemType& an_entry) const
+template<class ItemType, class Storage, class Index>
+bool ArrayBag<ItemType, Storage, Index>::contains(const ItemType& an_entry) const
 {
 	return getIndexOf(an_entry) > -1;
 }  // end contains
 
+/** @return an iterator to the first item **/
+template<class ItemType, class Storage, class Index>
+typename ArrayBag<ItemType, Storage, Index>::iterator ArrayBag<ItemType, Storage, Index>::begin()
+{
+	items_.makeUnique(item_count_);
+	return items_.data();
+}  // end begin
+
+template<class ItemType, class Storage, class Index>
+typename ArrayBag<ItemType, Storage, Index>::const_iterator ArrayBag<ItemType, Storage, Index>::begin() const
+{
+	return items_.data();
+}  // end begin
+
+template<class ItemType, class Storage, class Index>
+typename ArrayBag<ItemType, Storage, Index>::const_iterator ArrayBag<ItemType, Storage, Index>::cbegin() const
+{
+	return items_.data();
+}  // end cbegin
+
+/** @return an iterator one past the last item **/
+template<class ItemType, class Storage, class Index>
+typename ArrayBag<ItemType, Storage, Index>::iterator ArrayBag<ItemType, Storage, Index>::end()
+{
+	items_.makeUnique(item_count_);
+	return items_.data() + item_count_;
+}  // end end
+
+template<class ItemType, class Storage, class Index>
+typename ArrayBag<ItemType, Storage, Index>::const_iterator ArrayBag<ItemType, Storage, Index>::end() const
+{
+	return items_.data() + item_count_;
+}  // end end
+
+template<class ItemType, class Storage, class Index>
+typename ArrayBag<ItemType, Storage, Index>::const_iterator ArrayBag<ItemType, Storage, Index>::cend() const
+{
+	return items_.data() + item_count_;
+}  // end cend
+
+/** @return pointer to the first of getCurrentSize() contiguous items **/
+template<class ItemType, class Storage, class Index>
+typename ArrayBag<ItemType, Storage, Index>::iterator ArrayBag<ItemType, Storage, Index>::data()
+{
+	items_.makeUnique(item_count_);
+	return items_.data();
+}  // end data
+
+template<class ItemType, class Storage, class Index>
+typename ArrayBag<ItemType, Storage, Index>::const_iterator ArrayBag<ItemType, Storage, Index>::data() const
+{
+	return items_.data();
+}  // end data
+
+/**
+ @pre Storage is CowStorage<ItemType>
+ @return an immutable view of the bag as it is now, in O(1). The bag's array is
+         only copied if the bag is changed while the snapshot is still alive.
+ **/
+template<class ItemType, class Storage, class Index>
+BagSnapshot<ItemType> ArrayBag<ItemType, Storage, Index>::snapshot()
+{
+	return BagSnapshot<ItemType>(items_.share(item_count_), item_count_);
+}  // end snapshot
+
 // ********* PRIVATE METHODS **************//
 
 /**
@@ -109,9 +383,18 @@ bool ArrayBag<ItemType>::contains(const ItemType& an_entry) const
  	@return either the index target in the array items_ or -1,
  	if the array does not containthe target.
  **/
-template<class ItemType>
-int ArrayBag<ItemType>::getIndexOf(const ItemType& target) const
+template<class ItemType, class Storage, class Index>
+int ArrayBag<ItemType, Storage, Index>::getIndexOf(const ItemType& target) const
 {  
+   if constexpr (Index::INDEXED)
+   {
+      return Index::indexFind(target);
+   }
+   else if constexpr (IsScannable<ItemType>::value)
+   {
+      return scanFind(items_.data(), item_count_, target);
+   }  // end if
+
 	bool found = false;
   int result = -1;
   int search_index = 0;
@@ -133,43 +416,202 @@ int ArrayBag<ItemType>::getIndexOf(const ItemType& target) const
    return result;
 }  // end getIndexOf
 
-template<class ItemType>
-void ArrayBag<ItemType>::operator/=(const ArrayBag<ItemType> &rhs)
+template<class ItemType, class Storage, class Index>
+void ArrayBag<ItemType, Storage, Index>::operator/=(const ArrayBag<ItemType, Storage, Index> &rhs)
 {
   int index = 0;
   int itemsToAdd = rhs.item_count_;
   while (itemsToAdd > 0)
   {
-    if (this->item_count_ == DEFAULT_CAPACITY)
-    {
-      break;
-    }
     if (contains(rhs.items_[index]))
     {
       index++;
       itemsToAdd--;
       continue;
     }
-   this->add(rhs.items_[index]);
+    // Stop once a fixed-capacity bag is full
+    if (!this->add(rhs.items_[index]))
+    {
+      break;
+    }
 
    index++;
    itemsToAdd--;
   }
 }
 
-template<class ItemType>
-void ArrayBag<ItemType>::operator+=(const ArrayBag<ItemType> &rhs)
+template<class ItemType, class Storage, class Index>
+void ArrayBag<ItemType, Storage, Index>::operator+=(const ArrayBag<ItemType, Storage, Index> &rhs)
 {
   int index = 0;
   int itemsToAdd = rhs.item_count_;
+  // Grow once up front instead of doubling through the loop
+  reserve(item_count_ + itemsToAdd);
   while (itemsToAdd > 0)
   {
-   if (item_count_ == DEFAULT_CAPACITY)
+   // Stop once a fixed-capacity bag is full
+   if (!add(rhs.items_[index]))
    {
       break;
    }
-   add(rhs.items_[index]);
    index++;
    itemsToAdd--;
   }
+}
+
+/**
+    @param:   another ArrayBag object
+    @return:  a new bag holding this bag's items followed by each item of a_bag that isn't already there
+*/
+template<class ItemType, class Storage, class Index>
+ArrayBag<ItemType, Storage, Index> ArrayBag<ItemType, Storage, Index>::setUnion(const ArrayBag<ItemType, Storage, Index> &rhs) const
+{
+  std::unordered_set<ItemType, typename Index::hasher, typename Index::key_equal> seen;
+  seen.reserve(item_count_ + rhs.item_count_);
+
+  ArrayBag<ItemType, Storage, Index> result;
+  result.reserve(item_count_ + rhs.item_count_);
+  for (int i = 0; i < item_count_; i++)
+  {
+    seen.insert(items_[i]);
+    if (!result.add(items_[i]))
+    {
+      break;
+    }
+  }
+  for (int i = 0; i < rhs.item_count_; i++)
+  {
+    // Only the first sighting of each new item is added
+    if (seen.insert(rhs.items_[i]).second && !result.add(rhs.items_[i]))
+    {
+      break;
+    }
+  }
+  return result;
+}
+
+/**
+    @param:   another ArrayBag object
+    @param:   the bag to hold the result
+    @post:    out holds the same items setUnion returns; out may be either operand
+*/
+template<class ItemType, class Storage, class Index>
+void ArrayBag<ItemType, Storage, Index>::setUnion(const ArrayBag<ItemType, Storage, Index> &rhs, ArrayBag<ItemType, Storage, Index> &out) const
+{
+  out = setUnion(rhs);
+}
+
+/**
+    @param:   another ArrayBag object
+    @return:  a new bag holding the items found in both bags, each as many times as it appears in the bag with fewer of it
+*/
+template<class ItemType, class Storage, class Index>
+ArrayBag<ItemType, Storage, Index> ArrayBag<ItemType, Storage, Index>::setIntersection(const ArrayBag<ItemType, Storage, Index> &rhs) const
+{
+  // How many more of each item rhs can still match
+  std::unordered_map<ItemType, int, typename Index::hasher, typename Index::key_equal> remaining;
+  remaining.reserve(rhs.item_count_);
+  for (int i = 0; i < rhs.item_count_; i++)
+  {
+    remaining[rhs.items_[i]]++;
+  }
+
+  ArrayBag<ItemType, Storage, Index> result;
+  result.reserve(std::min(item_count_, rhs.item_count_));
+  for (int i = 0; i < item_count_; i++)
+  {
+    auto match = remaining.find(items_[i]);
+    if (match != remaining.end() && match->second > 0)
+    {
+      match->second--;
+      if (!result.add(items_[i]))
+      {
+        break;
+      }
+    }
+  }
+  return result;
+}
+
+/**
+    @param:   another ArrayBag object
+    @param:   the bag to hold the result
+    @post:    out holds the same items setIntersection returns; out may be either operand
+*/
+template<class ItemType, class Storage, class Index>
+void ArrayBag<ItemType, Storage, Index>::setIntersection(const ArrayBag<ItemType, Storage, Index> &rhs, ArrayBag<ItemType, Storage, Index> &out) const
+{
+  out = setIntersection(rhs);
+}
+
+/**
+    @param:   another ArrayBag object
+    @return:  a new bag holding this bag's items with one occurrence removed for each occurrence in a_bag
+*/
+template<class ItemType, class Storage, class Index>
+ArrayBag<ItemType, Storage, Index> ArrayBag<ItemType, Storage, Index>::setDifference(const ArrayBag<ItemType, Storage, Index> &rhs) const
+{
+  // How many more of each item rhs can still cancel
+  std::unordered_map<ItemType, int, typename Index::hasher, typename Index::key_equal> remaining;
+  remaining.reserve(rhs.item_count_);
+  for (int i = 0; i < rhs.item_count_; i++)
+  {
+    remaining[rhs.items_[i]]++;
+  }
+
+  ArrayBag<ItemType, Storage, Index> result;
+  result.reserve(item_count_);
+  for (int i = 0; i < item_count_; i++)
+  {
+    auto match = remaining.find(items_[i]);
+    if (match != remaining.end() && match->second > 0)
+    {
+      match->second--;
+      continue;
+    }
+    if (!result.add(items_[i]))
+    {
+      break;
+    }
+  }
+  return result;
+}
+
+/**
+    @param:   another ArrayBag object
+    @param:   the bag to hold the result
+    @post:    out holds the same items setDifference returns; out may be either operand
+*/
+template<class ItemType, class Storage, class Index>
+void ArrayBag<ItemType, Storage, Index>::setDifference(const ArrayBag<ItemType, Storage, Index> &rhs, ArrayBag<ItemType, Storage, Index> &out) const
+{
+  out = setDifference(rhs);
+}
+
+/**
+    @param:   another ArrayBag object
+    @return:  a new bag holding the items of both bags, including duplicates
+*/
+template<class ItemType, class Storage, class Index>
+ArrayBag<ItemType, Storage, Index> ArrayBag<ItemType, Storage, Index>::multisetSum(const ArrayBag<ItemType, Storage, Index> &rhs) const
+{
+  ArrayBag<ItemType, Storage, Index> result(*this);
+  result += rhs;
+  return result;
+}
+
+/**
+    @param:   another ArrayBag object
+    @param:   the bag to hold the result
+    @post:    out holds the same items multisetSum returns; out may be either operand
+*/
+template<class ItemType, class Storage, class Index>
+void ArrayBag<ItemType, Storage, Index>::multisetSum(const ArrayBag<ItemType, Storage, Index> &rhs, ArrayBag<ItemType, Storage, Index> &out) const
+{
+  if (&out == this)
+  {
+    out += rhs;
+    return;
+  }
+  out = multisetSum(rhs);
 }
\ No newline at end of file
@@ -6,16 +6,51 @@ CSCI 235 Spring 2024
 #ifndef ARRAY_BAG_
 #define ARRAY_BAG_
 #include <iostream>
+#include <type_traits>
 #include <vector>
-
-template <class ItemType>
-class ArrayBag
+#include "BagStorage.hpp"
+#include "BagIndex.hpp"
+#include "BagScan.hpp"
+
+/**
+    @param ItemType the type of the items in the bag
+    @param Storage the storage policy backing items_ (see BagStorage.hpp).
+           Defaults to a fixed inline array of 100 items.
+    @param Index the index policy kept in sync with items_ (see BagIndex.hpp).
+           Defaults to no index, i.e. linear scans.
+**/
+template <class ItemType, class Storage = FixedStorage<ItemType>, class Index = NoIndex<ItemType>>
+class ArrayBag : private Index  // inherited so that NoIndex takes up no space
 {
 
    public:
+   /*
+       Iterators are plain pointers into items_, so they are contiguous and random access
+       and work with the standard (and parallel) algorithms. They are invalidated by any
+       add, remove or growth. Indexed bags only hand out read-only iterators, since
+       writing through one would bypass the index.
+   */
+   typedef std::conditional_t<Index::INDEXED, const ItemType *, ItemType *> iterator;
+   typedef const ItemType *const_iterator;
+
    /** default constructor**/
    ArrayBag();
 
+   /** copy constructor: copies the items of a_bag **/
+   ArrayBag(const ArrayBag &a_bag);
+
+   /** move constructor: takes the items of a_bag, leaving it empty **/
+   ArrayBag(ArrayBag &&a_bag);
+
+   /** @post this bag holds copies of the items of a_bag **/
+   ArrayBag &operator=(const ArrayBag &a_bag);
+
+   /** @post this bag holds the items of a_bag, which is left empty **/
+   ArrayBag &operator=(ArrayBag &&a_bag);
+
+   /** destructor: destroys every item in the bag **/
+   ~ArrayBag();
+
    /**
        @return item_count_ : the current size of the bag
    **/
@@ -26,18 +61,67 @@ class ArrayBag
    **/
    bool isEmpty() const;
 
+   /**
+       @return the number of items the bag can hold before it has to grow
+   **/
+   int getCapacity() const;
+
+   /**
+       @param new_capacity the number of items the bag should be able to hold
+       @post getCapacity() >= new_capacity, if the storage policy allows it
+       @return true if the bag can now hold new_capacity items, false otherwise
+   **/
+   bool reserve(int new_capacity);
+
+   /**
+       @post releases unused capacity, if the storage policy allows it
+   **/
+   void shrinkToFit();
+
    /**
        @return true if new_entry was successfully added to items_, false otherwise
    **/
    bool add(const ItemType &new_entry);
 
    /**
+       @post new_entry is moved into items_
+       @return true if new_entry was successfully added to items_, false otherwise
+   **/
+   bool add(ItemType &&new_entry);
+
+   /**
+       @param args the constructor arguments of the new item
+       @post a new item is constructed in place at the end of items_
+       @return true if the item was successfully added to items_, false otherwise
+   **/
+   template <class... Args>
+   bool emplace(Args &&...args);
+
+   /**
+       @post the last item is moved into the vacated slot, and the last slot is destroyed
        @return true if an_entry was successfully removed from items_, false otherwise
       **/
    bool remove(const ItemType &an_entry);
 
    /**
-       @post item_count_ == 0
+       @param index the slot of the item to remove
+       @post the last item is moved into slot index, and the last slot is destroyed. O(1)
+       @return true if 0 <= index < item_count_ and the item was removed, false otherwise
+   **/
+   bool eraseAt(int index);
+
+   /**
+       @param pred called once on each item, in order, returning true for items to remove
+       @post every item for which pred returned true is removed in a single pass;
+             the remaining items keep their relative order. If pred throws, the items it
+             had already picked are removed, the rest are kept, and the exception is rethrown
+       @return the number of items removed
+   **/
+   template <class Predicate>
+   int removeIf(Predicate pred);
+
+   /**
+       @post item_count_ == 0 and every item has been destroyed
       **/
    void clear();
 
@@ -51,12 +135,33 @@ class ArrayBag
    **/
    int getFrequencyOf(const ItemType &an_entry) const;
 
+   /** @return an iterator to the first item **/
+   iterator begin();
+   const_iterator begin() const;
+   const_iterator cbegin() const;
+
+   /** @return an iterator one past the last item **/
+   iterator end();
+   const_iterator end() const;
+   const_iterator cend() const;
+
+   /** @return pointer to the first of getCurrentSize() contiguous items **/
+   iterator data();
+   const_iterator data() const;
+
+   /**
+       @pre Storage is CowStorage<ItemType>
+       @return an immutable view of the bag as it is now, in O(1). The bag's array is
+               only copied if the bag is changed while the snapshot is still alive.
+   **/
+   BagSnapshot<ItemType> snapshot();
+
    /** 
     * @param:   another ArrayBag object
     @post:    Combines the contents from both ArrayBag objects, EXCLUDING duplicates.
     Example: [1, 2, 3] /= [1, 4] will produce [1, 2, 3, 4]
     */
-    void operator/= (const ArrayBag<ItemType>& a_bag);
+    void operator/= (const ArrayBag& a_bag);
 
 
     /**
@@ -65,11 +170,74 @@ class ArrayBag
                                 adding items from the argument bag as long as there is space.
                             Example: [1, 2, 3] += [1, 4] will produce [1, 2, 3, 1, 4]
     */
-    void operator+= (const ArrayBag<ItemType>& a_bag);
+    void operator+= (const ArrayBag& a_bag);
+
+    /*
+        The bulk operations below run in O(n + m) expected using a hash table
+        built with the index policy's hasher/key_equal. Neither operand is modified;
+        each returns the result as a new bag, or writes it to out, which may also be
+        this bag or a_bag. Like the operators, a fixed-capacity result stops accepting
+        items once full.
+    */
+
+    /**
+        @param:   another ArrayBag object
+        @param:   the bag to hold the result
+        @post:    out holds this bag's items followed by each item of a_bag that isn't already there.
+                  Same result as /=. Example: [1, 2, 3] and [1, 4, 4] produce [1, 2, 3, 4]
+    */
+    void setUnion(const ArrayBag& a_bag, ArrayBag& out) const;
+
+    /**
+        @param:   another ArrayBag object
+        @return:  a new bag holding this bag's items followed by each item of a_bag that isn't already there
+    */
+    ArrayBag setUnion(const ArrayBag& a_bag) const;
+
+    /**
+        @param:   another ArrayBag object
+        @param:   the bag to hold the result
+        @post:    out holds the items found in both bags, each as many times as it appears in the bag with fewer of it.
+                  Example: [1, 1, 2, 3] and [1, 1, 1, 3] produce [1, 1, 3]
+    */
+    void setIntersection(const ArrayBag& a_bag, ArrayBag& out) const;
+
+    /**
+        @param:   another ArrayBag object
+        @return:  a new bag holding the items found in both bags, each as many times as it appears in the bag with fewer of it
+    */
+    ArrayBag setIntersection(const ArrayBag& a_bag) const;
+
+    /**
+        @param:   another ArrayBag object
+        @param:   the bag to hold the result
+        @post:    out holds this bag's items with one occurrence removed for each occurrence in a_bag.
+                  Example: [1, 1, 2, 3] and [1, 3, 4] produce [1, 2]
+    */
+    void setDifference(const ArrayBag& a_bag, ArrayBag& out) const;
+
+    /**
+        @param:   another ArrayBag object
+        @return:  a new bag holding this bag's items with one occurrence removed for each occurrence in a_bag
+    */
+    ArrayBag setDifference(const ArrayBag& a_bag) const;
+
+    /**
+        @param:   another ArrayBag object
+        @param:   the bag to hold the result
+        @post:    out holds the items of both bags, including duplicates. Same result as +=.
+                  Example: [1, 2, 3] and [1, 4] produce [1, 2, 3, 1, 4]
+    */
+    void multisetSum(const ArrayBag& a_bag, ArrayBag& out) const;
+
+    /**
+        @param:   another ArrayBag object
+        @return:  a new bag holding the items of both bags, including duplicates
+    */
+    ArrayBag multisetSum(const ArrayBag& a_bag) const;
 
    protected:
-   static const int DEFAULT_CAPACITY = 100; //max size of items_ at 100 by default for this project
-   ItemType items_[DEFAULT_CAPACITY];      // Array of bag items
+   Storage items_;                         // Array of bag items, live in [0, item_count_)
    int item_count_;                        // Current count of bag items
 
    /**
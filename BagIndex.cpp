@@ -0,0 +1,74 @@
+/*
+Index policies for ArrayBag.
+*/
+
+#include "BagIndex.hpp"
+
+template<class ItemType, class Hash, class KeyEqual>
+void HashIndex<ItemType, Hash, KeyEqual>::indexAdd(const ItemType& item, int index)
+{
+	std::vector<int>& slots = slots_[item];
+	if (index >= static_cast<int>(where_.size()))
+	{
+		where_.resize(index + 1);
+	}  // end if
+	where_[index] = static_cast<int>(slots.size());
+	slots.push_back(index);
+}  // end indexAdd
+
+template<class ItemType, class Hash, class KeyEqual>
+void HashIndex<ItemType, Hash, KeyEqual>::indexErase(const ItemType& item, int index)
+{
+	auto found = slots_.find(item);
+	if (found == slots_.end())
+	{
+		return;
+	}  // end if
+
+	// Order of slots doesn't matter, so the last one takes the erased one's place
+	std::vector<int>& slots = found->second;
+	int last = slots.back();
+	slots[where_[index]] = last;
+	where_[last] = where_[index];
+	slots.pop_back();
+
+	if (slots.empty())
+	{
+		slots_.erase(found);
+	}  // end if
+}  // end indexErase
+
+template<class ItemType, class Hash, class KeyEqual>
+void HashIndex<ItemType, Hash, KeyEqual>::indexMove(const ItemType& item, int from, int to)
+{
+	auto found = slots_.find(item);
+	if (found == slots_.end())
+	{
+		return;
+	}  // end if
+
+	// to has been vacated, so its entry in where_ is free
+	found->second[where_[from]] = to;
+	where_[to] = where_[from];
+}  // end indexMove
+
+template<class ItemType, class Hash, class KeyEqual>
+void HashIndex<ItemType, Hash, KeyEqual>::indexClear()
+{
+	slots_.clear();
+	where_.clear();
+}  // end indexClear
+
+template<class ItemType, class Hash, class KeyEqual>
+int HashIndex<ItemType, Hash, KeyEqual>::indexFind(const ItemType& target) const
+{
+	auto found = slots_.find(target);
+	return (found == slots_.end()) ? -1 : found->second.front();
+}  // end indexFind
+
+template<class ItemType, class Hash, class KeyEqual>
+int HashIndex<ItemType, Hash, KeyEqual>::indexCount(const ItemType& target) const
+{
+	auto found = slots_.find(target);
+	return (found == slots_.end()) ? 0 : static_cast<int>(found->second.size());
+}  // end indexCount
@@ -0,0 +1,85 @@
+/*
+Index policies for ArrayBag.
+An index policy is told about every slot ArrayBag fills, vacates or moves, and
+answers contains/getIndexOf/getFrequencyOf without scanning items_.
+*/
+
+#ifndef BAG_INDEX_
+#define BAG_INDEX_
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+/**
+    No index: ArrayBag scans items_ linearly.
+    Empty, so it adds nothing to the size of the bag.
+**/
+template <class ItemType>
+class NoIndex
+{
+   public:
+   static constexpr bool INDEXED = false;
+   typedef std::hash<ItemType> hasher;
+   typedef std::equal_to<ItemType> key_equal;
+
+   void indexAdd(const ItemType &item, int index) {}
+   void indexErase(const ItemType &item, int index) {}
+   void indexMove(const ItemType &item, int from, int to) {}
+   void indexClear() {}
+}; // end NoIndex
+
+/**
+    Hash index from each distinct item to the slots holding it,
+    making contains/getIndexOf/getFrequencyOf O(1) expected.
+    @param Hash hash function for ItemType
+    @param KeyEqual equality used for lookups (in place of operator==)
+**/
+template <class ItemType, class Hash = std::hash<ItemType>, class KeyEqual = std::equal_to<ItemType>>
+class HashIndex
+{
+   public:
+   static constexpr bool INDEXED = true;
+   typedef Hash hasher;
+   typedef KeyEqual key_equal;
+
+   /**
+       @param item the item now stored at index
+       @param index the slot that was filled
+   **/
+   void indexAdd(const ItemType &item, int index);
+
+   /**
+       @param item the item stored at index
+       @param index the slot about to be vacated
+       @post O(1), however many slots hold item
+   **/
+   void indexErase(const ItemType &item, int index);
+
+   /**
+       @param item the item being moved
+       @param from the slot it is leaving
+       @param to the slot it is moving into
+   **/
+   void indexMove(const ItemType &item, int from, int to);
+
+   /** @post the index is empty **/
+   void indexClear();
+
+   /**
+       @return a slot holding target, or -1 if there is none
+   **/
+   int indexFind(const ItemType &target) const;
+
+   /**
+       @return the number of slots holding target
+   **/
+   int indexCount(const ItemType &target) const;
+
+   private:
+   std::unordered_map<ItemType, std::vector<int>, Hash, KeyEqual> slots_;
+   std::vector<int> where_;  // slot -> its position in slots_[item], so erase and move are O(1)
+}; // end HashIndex
+
+#include "BagIndex.cpp"
+#endif
@@ -0,0 +1,334 @@
+/*
+Vectorized linear scans used by ArrayBag when it has no index.
+*/
+
+#include "BagScan.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BAG_SCAN_X86_
+#include <immintrin.h>
+#endif
+
+// ********* Portable fallback **************//
+
+// Keys are read with memcpy since the items aren't necessarily of type Key
+template<class Key>
+static int findScalar(const void* items, int from, int count, Key target)
+{
+	const unsigned char* bytes = static_cast<const unsigned char*>(items);
+	for (int i = from; i < count; i++)
+	{
+		Key key;
+		std::memcpy(&key, bytes + i * sizeof(Key), sizeof(Key));
+		if (key == target)
+		{
+			return i;
+		}  // end if
+	}  // end for
+	return -1;
+}  // end findScalar
+
+template<class Key>
+static int countScalar(const void* items, int from, int count, Key target)
+{
+	const unsigned char* bytes = static_cast<const unsigned char*>(items);
+	int frequency = 0;
+	for (int i = from; i < count; i++)
+	{
+		Key key;
+		std::memcpy(&key, bytes + i * sizeof(Key), sizeof(Key));
+		frequency += (key == target);
+	}  // end for
+	return frequency;
+}  // end countScalar
+
+static int find32Scalar(const void* items, int count, std::uint32_t target)
+{
+	return findScalar(items, 0, count, target);
+}
+
+static int count32Scalar(const void* items, int count, std::uint32_t target)
+{
+	return countScalar(items, 0, count, target);
+}
+
+static int find64Scalar(const void* items, int count, std::uint64_t target)
+{
+	return findScalar(items, 0, count, target);
+}
+
+static int count64Scalar(const void* items, int count, std::uint64_t target)
+{
+	return countScalar(items, 0, count, target);
+}
+
+#ifdef BAG_SCAN_X86_
+
+// ********* SSE2 (4 x 32-bit, 2 x 64-bit lanes) **************//
+
+// SSE2 has no 64-bit compare, so a 64-bit lane matches when both of its 32-bit halves do
+__attribute__((target("sse2")))
+static inline __m128i cmpeq64Sse2(__m128i a, __m128i b)
+{
+	__m128i eq32 = _mm_cmpeq_epi32(a, b);
+	return _mm_and_si128(eq32, _mm_shuffle_epi32(eq32, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+__attribute__((target("sse2")))
+static int find32Sse2(const void* items, int count, std::uint32_t target)
+{
+	const __m128i* lanes = static_cast<const __m128i*>(items);
+	const __m128i key = _mm_set1_epi32(static_cast<int>(target));
+	int i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_loadu_si128(lanes + i / 4), key)));
+		if (mask)
+		{
+			return i + __builtin_ctz(mask);
+		}  // end if
+	}  // end for
+	return findScalar(items, i, count, target);
+}
+
+__attribute__((target("sse2")))
+static int count32Sse2(const void* items, int count, std::uint32_t target)
+{
+	const __m128i* lanes = static_cast<const __m128i*>(items);
+	const __m128i key = _mm_set1_epi32(static_cast<int>(target));
+	// A match compares as -1, so subtracting counts it
+	__m128i matches = _mm_setzero_si128();
+	int i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		matches = _mm_sub_epi32(matches, _mm_cmpeq_epi32(_mm_loadu_si128(lanes + i / 4), key));
+	}  // end for
+
+	alignas(16) std::int32_t sums[4];
+	_mm_store_si128(reinterpret_cast<__m128i*>(sums), matches);
+	return sums[0] + sums[1] + sums[2] + sums[3] + countScalar(items, i, count, target);
+}
+
+__attribute__((target("sse2")))
+static int find64Sse2(const void* items, int count, std::uint64_t target)
+{
+	const __m128i* lanes = static_cast<const __m128i*>(items);
+	const __m128i key = _mm_set1_epi64x(static_cast<long long>(target));
+	int i = 0;
+	for (; i + 2 <= count; i += 2)
+	{
+		int mask = _mm_movemask_pd(_mm_castsi128_pd(cmpeq64Sse2(_mm_loadu_si128(lanes + i / 2), key)));
+		if (mask)
+		{
+			return i + __builtin_ctz(mask);
+		}  // end if
+	}  // end for
+	return findScalar(items, i, count, target);
+}
+
+__attribute__((target("sse2")))
+static int count64Sse2(const void* items, int count, std::uint64_t target)
+{
+	const __m128i* lanes = static_cast<const __m128i*>(items);
+	const __m128i key = _mm_set1_epi64x(static_cast<long long>(target));
+	__m128i matches = _mm_setzero_si128();
+	int i = 0;
+	for (; i + 2 <= count; i += 2)
+	{
+		matches = _mm_sub_epi64(matches, cmpeq64Sse2(_mm_loadu_si128(lanes + i / 2), key));
+	}  // end for
+
+	alignas(16) std::int64_t sums[2];
+	_mm_store_si128(reinterpret_cast<__m128i*>(sums), matches);
+	return static_cast<int>(sums[0] + sums[1]) + countScalar(items, i, count, target);
+}
+
+// ********* AVX2 (8 x 32-bit, 4 x 64-bit lanes) **************//
+
+__attribute__((target("avx2")))
+static int find32Avx2(const void* items, int count, std::uint32_t target)
+{
+	const __m256i* lanes = static_cast<const __m256i*>(items);
+	const __m256i key = _mm256_set1_epi32(static_cast<int>(target));
+	int i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_loadu_si256(lanes + i / 8), key)));
+		if (mask)
+		{
+			return i + __builtin_ctz(mask);
+		}  // end if
+	}  // end for
+	return findScalar(items, i, count, target);
+}
+
+__attribute__((target("avx2")))
+static int count32Avx2(const void* items, int count, std::uint32_t target)
+{
+	const __m256i* lanes = static_cast<const __m256i*>(items);
+	const __m256i key = _mm256_set1_epi32(static_cast<int>(target));
+	__m256i matches = _mm256_setzero_si256();
+	int i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		matches = _mm256_sub_epi32(matches, _mm256_cmpeq_epi32(_mm256_loadu_si256(lanes + i / 8), key));
+	}  // end for
+
+	alignas(32) std::int32_t sums[8];
+	_mm256_store_si256(reinterpret_cast<__m256i*>(sums), matches);
+	int frequency = 0;
+	for (int lane = 0; lane < 8; lane++)
+	{
+		frequency += sums[lane];
+	}  // end for
+	return frequency + countScalar(items, i, count, target);
+}
+
+__attribute__((target("avx2")))
+static int find64Avx2(const void* items, int count, std::uint64_t target)
+{
+	const __m256i* lanes = static_cast<const __m256i*>(items);
+	const __m256i key = _mm256_set1_epi64x(static_cast<long long>(target));
+	int i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		int mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_loadu_si256(lanes + i / 4), key)));
+		if (mask)
+		{
+			return i + __builtin_ctz(mask);
+		}  // end if
+	}  // end for
+	return findScalar(items, i, count, target);
+}
+
+__attribute__((target("avx2")))
+static int count64Avx2(const void* items, int count, std::uint64_t target)
+{
+	const __m256i* lanes = static_cast<const __m256i*>(items);
+	const __m256i key = _mm256_set1_epi64x(static_cast<long long>(target));
+	__m256i matches = _mm256_setzero_si256();
+	int i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		matches = _mm256_sub_epi64(matches, _mm256_cmpeq_epi64(_mm256_loadu_si256(lanes + i / 4), key));
+	}  // end for
+
+	alignas(32) std::int64_t sums[4];
+	_mm256_store_si256(reinterpret_cast<__m256i*>(sums), matches);
+	return static_cast<int>(sums[0] + sums[1] + sums[2] + sums[3]) + countScalar(items, i, count, target);
+}
+
+#endif // BAG_SCAN_X86_
+
+// ********* Dispatch **************//
+
+struct ScanKernels
+{
+	ScanPath path;
+	int (*find32)(const void*, int, std::uint32_t);
+	int (*count32)(const void*, int, std::uint32_t);
+	int (*find64)(const void*, int, std::uint64_t);
+	int (*count64)(const void*, int, std::uint64_t);
+};
+
+/*
+    @param path a kernel set
+    @param kernels set to the kernels of path
+    @return true if this CPU supports path
+*/
+static bool kernelsFor(ScanPath path, ScanKernels& kernels)
+{
+#ifdef BAG_SCAN_X86_
+	__builtin_cpu_init();
+	if (path == ScanPath::AVX2 && __builtin_cpu_supports("avx2"))
+	{
+		kernels = { ScanPath::AVX2, find32Avx2, count32Avx2, find64Avx2, count64Avx2 };
+		return true;
+	}  // end if
+	if (path == ScanPath::SSE2 && __builtin_cpu_supports("sse2"))
+	{
+		kernels = { ScanPath::SSE2, find32Sse2, count32Sse2, find64Sse2, count64Sse2 };
+		return true;
+	}  // end if
+#endif
+	if (path == ScanPath::SCALAR)
+	{
+		kernels = { ScanPath::SCALAR, find32Scalar, count32Scalar, find64Scalar, count64Scalar };
+		return true;
+	}  // end if
+	return false;
+}
+
+/*
+    @return the fastest kernels this CPU supports
+*/
+static ScanKernels pickKernels()
+{
+	ScanKernels picked;
+	if (!kernelsFor(ScanPath::AVX2, picked) && !kernelsFor(ScanPath::SSE2, picked))
+	{
+		kernelsFor(ScanPath::SCALAR, picked);
+	}  // end if
+	return picked;
+}
+
+/*
+    @return the kernels in use, picked on first use
+*/
+static ScanKernels& kernels()
+{
+	static ScanKernels picked = pickKernels();
+	return picked;
+}
+
+/** @return the kernel set scans use: the fastest this CPU supports, unless setScanPath chose another **/
+ScanPath scanPath()
+{
+	return kernels().path;
+}
+
+/**
+    Forces a kernel set, so benchmarks and tests can compare them.
+    Not thread safe: call it while no scan is running.
+    @return true if this CPU supports path, false (changing nothing) otherwise
+**/
+bool setScanPath(ScanPath path)
+{
+	return kernelsFor(path, kernels());
+}
+
+/**
+    @param items the first of count 4-byte keys
+    @return the index of the first key equal to target, or -1 if there is none
+**/
+int scanFind32(const void* items, int count, std::uint32_t target)
+{
+	return kernels().find32(items, count, target);
+}
+
+/**
+    @param items the first of count 4-byte keys
+    @return the number of keys equal to target
+**/
+int scanCount32(const void* items, int count, std::uint32_t target)
+{
+	return kernels().count32(items, count, target);
+}
+
+/**
+    @param items the first of count 8-byte keys
+    @return the index of the first key equal to target, or -1 if there is none
+**/
+int scanFind64(const void* items, int count, std::uint64_t target)
+{
+	return kernels().find64(items, count, target);
+}
+
+/**
+    @param items the first of count 8-byte keys
+    @return the number of keys equal to target
+**/
+int scanCount64(const void* items, int count, std::uint64_t target)
+{
+	return kernels().count64(items, count, target);
+}
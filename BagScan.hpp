@@ -0,0 +1,109 @@
+/*
+Vectorized linear scans used by ArrayBag when it has no index.
+Kernels exist for 4- and 8-byte keys; the best one the CPU supports
+(AVX2, then SSE2, then plain C++) is picked once at first use.
+*/
+
+#ifndef BAG_SCAN_
+#define BAG_SCAN_
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+    True for item types whose operator== is plain bitwise equality of a 4- or 8-byte value:
+    integers, enums and pointers. (Floating point is excluded, since NaN != NaN and 0.0 == -0.0.)
+**/
+template <class ItemType>
+struct IsScannable : std::integral_constant<bool,
+   (std::is_integral<ItemType>::value || std::is_enum<ItemType>::value || std::is_pointer<ItemType>::value)
+   && (sizeof(ItemType) == 4 || sizeof(ItemType) == 8)>
+{
+};
+
+/** Kernel sets a scan can run on, slowest first **/
+enum class ScanPath
+{
+   SCALAR,
+   SSE2,
+   AVX2
+};
+
+/** @return the kernel set scans use: the fastest this CPU supports, unless setScanPath chose another **/
+ScanPath scanPath();
+
+/**
+    Forces a kernel set, so benchmarks and tests can compare them.
+    Not thread safe: call it while no scan is running.
+    @return true if this CPU supports path, false (changing nothing) otherwise
+**/
+bool setScanPath(ScanPath path);
+
+/**
+    @param items the first of count 4-byte keys
+    @return the index of the first key equal to target, or -1 if there is none
+**/
+int scanFind32(const void *items, int count, std::uint32_t target);
+
+/**
+    @param items the first of count 4-byte keys
+    @return the number of keys equal to target
+**/
+int scanCount32(const void *items, int count, std::uint32_t target);
+
+/**
+    @param items the first of count 8-byte keys
+    @return the index of the first key equal to target, or -1 if there is none
+**/
+int scanFind64(const void *items, int count, std::uint64_t target);
+
+/**
+    @param items the first of count 8-byte keys
+    @return the number of keys equal to target
+**/
+int scanCount64(const void *items, int count, std::uint64_t target);
+
+/**
+    @pre IsScannable<ItemType>
+    @return the index of the first of count items equal to target, or -1 if there is none
+**/
+template <class ItemType>
+int scanFind(const ItemType *items, int count, const ItemType &target)
+{
+   if constexpr (sizeof(ItemType) == 4)
+   {
+      std::uint32_t key;
+      std::memcpy(&key, &target, sizeof(key));
+      return scanFind32(items, count, key);
+   }
+   else
+   {
+      std::uint64_t key;
+      std::memcpy(&key, &target, sizeof(key));
+      return scanFind64(items, count, key);
+   }  // end if
+}  // end scanFind
+
+/**
+    @pre IsScannable<ItemType>
+    @return the number of the count items equal to target
+**/
+template <class ItemType>
+int scanCount(const ItemType *items, int count, const ItemType &target)
+{
+   if constexpr (sizeof(ItemType) == 4)
+   {
+      std::uint32_t key;
+      std::memcpy(&key, &target, sizeof(key));
+      return scanCount32(items, count, key);
+   }
+   else
+   {
+      std::uint64_t key;
+      std::memcpy(&key, &target, sizeof(key));
+      return scanCount64(items, count, key);
+   }  // end if
+}  // end scanCount
+
+#endif
@@ -0,0 +1,87 @@
+/*
+Benchmark for ArrayBag's bulk set operations.
+Times setUnion against copying the bag and applying /=, and multisetSum against copying
+the bag and applying +=, for two bags of n ints that share half their items, at several n.
+setIntersection and setDifference have no operator to compare with, so they are timed alone.
+Build and run with `make bagsetops_bench && ./bagsetops_bench`.
+*/
+
+#include "ArrayBag.hpp"
+#include <chrono>
+#include <cstdio>
+
+typedef ArrayBag<int, GrowableStorage<int>> Bag;
+
+// Stops the compiler from dropping results whose sizes are unused
+static volatile long long sink;
+
+/*
+    @param name the operation
+    @param operation called repeatedly, returning a bag
+    @post prints the time per call
+*/
+template<class Operation>
+static void timeOperation(const char* name, Operation operation)
+{
+	// Repeat for about a fifth of a second, whatever the size
+	int repeats = 0;
+	long long total = 0;
+	double seconds = 0;
+	auto start = std::chrono::steady_clock::now();
+	while (seconds < 0.2)
+	{
+		total += operation().getCurrentSize();
+		repeats++;
+		seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}  // end while
+	sink = total;
+	std::printf("  %-16s %12.3f us/call\n", name, seconds / repeats * 1e6);
+}
+
+/*
+    @param n how many items each bag holds
+    @param with_operators whether to time /= as well, which is O(n * m)
+    @post prints the timings for bags of n items
+*/
+static void benchSize(int n, bool with_operators)
+{
+	// lhs holds 0..n-1 and rhs holds n/2..n/2+n-1
+	Bag lhs;
+	Bag rhs;
+	for (int i = 0; i < n; i++)
+	{
+		lhs.add(i);
+		rhs.add(n / 2 + i);
+	}  // end for
+
+	std::printf("%d items per bag\n", n);
+	timeOperation("setUnion", [&]() { return lhs.setUnion(rhs); });
+	if (with_operators)
+	{
+		timeOperation("copy + /=", [&]() {
+			Bag result(lhs);
+			result /= rhs;
+			return result;
+		});
+	}  // end if
+	timeOperation("multisetSum", [&]() { return lhs.multisetSum(rhs); });
+	timeOperation("copy + +=", [&]() {
+		Bag result(lhs);
+		result += rhs;
+		return result;
+	});
+	timeOperation("setIntersection", [&]() { return lhs.setIntersection(rhs); });
+	timeOperation("setDifference", [&]() { return lhs.setDifference(rhs); });
+}
+
+int main()
+{
+	for (int n : { 100, 1000, 10000, 100000 })
+	{
+		benchSize(n, true);
+	}  // end for
+
+	// Past this, one /= takes minutes
+	benchSize(1000000, false);
+	return 0;
+}
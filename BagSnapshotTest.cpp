@@ -0,0 +1,79 @@
+/*
+Test for ArrayBag snapshots over CowStorage.
+A snapshot must keep the items it saw while the bag is changed, grown, shrunk or
+emptied underneath it, and the bag must write in place again once it is dropped.
+Build and run with `make bagsnapshot_test && ./bagsnapshot_test`.
+*/
+
+#include "ArrayBag.hpp"
+#include <cstdio>
+#include <string>
+
+typedef ArrayBag<std::string, CowStorage<std::string>> CowBag;
+
+static int failures = 0;
+
+/*
+    @param passed whether the check held
+    @param what the check, printed if it did not
+*/
+static void check(bool passed, const char* what)
+{
+	if (!passed)
+	{
+		std::printf("FAILED: %s\n", what);
+		failures++;
+	}  // end if
+}
+
+int main()
+{
+	{
+		// Emptied bag shrunk while a snapshot holds its block
+		CowBag bag;
+		bag.add("a");
+		bag.add("b");
+		bag.remove("a");
+		bag.remove("b");
+		BagSnapshot<std::string> view = bag.snapshot();
+		bag.shrinkToFit();
+		check(bag.isEmpty() && view.isEmpty(), "shrinking an emptied, snapshotted bag");
+		bag.add("c");
+		check(bag.getCurrentSize() == 1 && view.isEmpty(), "adding after shrinking an emptied, snapshotted bag");
+	}
+
+	{
+		// Shrunk with items while a snapshot holds its block
+		CowBag bag;
+		for (int i = 0; i < 10; i++)
+		{
+			bag.add(std::to_string(i));
+		}  // end for
+		BagSnapshot<std::string> view = bag.snapshot();
+		bag.remove("0");
+		bag.shrinkToFit();
+		check(view.getCurrentSize() == 10 && view.contains("0"), "snapshot keeping its items through shrinkToFit");
+		check(bag.getCurrentSize() == 9 && !bag.contains("0") && bag.contains("9"), "bag shrunk under a snapshot");
+	}
+
+	{
+		// Changed while one snapshot is alive, then again once it is dropped
+		CowBag bag;
+		bag.add("x");
+		{
+			BagSnapshot<std::string> view = bag.snapshot();
+			BagSnapshot<std::string> copy = view;
+			bag.add("y");
+			check(view.getCurrentSize() == 1 && copy.getCurrentSize() == 1, "snapshots not seeing a later add");
+		}
+		bag.add("z");
+		check(bag.getCurrentSize() == 3 && bag.contains("y") && bag.contains("z"), "bag writing after its snapshots are dropped");
+	}
+
+	if (failures > 0)
+	{
+		return 1;
+	}  // end if
+	std::printf("passed\n");
+	return 0;
+}
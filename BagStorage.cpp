@@ -0,0 +1,575 @@
+/*
+Storage policies for ArrayBag.
+*/
+
+#include "BagStorage.hpp"
+#include "BagScan.hpp"
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+/*
+    @param from the first of size live items
+    @param to uninitialized memory for size items
+    @post the items are move-constructed at to and destroyed at from
+*/
+template<class ItemType>
+void relocateItems(ItemType* from, int size, ItemType* to)
+{
+	std::uninitialized_move(from, from + size, to);
+	std::destroy(from, from + size);
+}  // end relocateItems
+
+// ********* FixedStorage **************//
+
+template<class ItemType, int CAPACITY>
+ItemType& FixedStorage<ItemType, CAPACITY>::operator[](int index)
+{
+	return data()[index];
+}  // end operator[]
+
+template<class ItemType, int CAPACITY>
+const ItemType& FixedStorage<ItemType, CAPACITY>::operator[](int index) const
+{
+	return data()[index];
+}  // end operator[]
+
+template<class ItemType, int CAPACITY>
+ItemType* FixedStorage<ItemType, CAPACITY>::data()
+{
+	return reinterpret_cast<ItemType*>(slots_);
+}  // end data
+
+template<class ItemType, int CAPACITY>
+const ItemType* FixedStorage<ItemType, CAPACITY>::data() const
+{
+	return reinterpret_cast<const ItemType*>(slots_);
+}  // end data
+
+template<class ItemType, int CAPACITY>
+int FixedStorage<ItemType, CAPACITY>::getCapacity() const
+{
+	return CAPACITY;
+}  // end getCapacity
+
+template<class ItemType, int CAPACITY>
+bool FixedStorage<ItemType, CAPACITY>::makeRoom(int size)
+{
+	return size < CAPACITY;
+}  // end makeRoom
+
+template<class ItemType, int CAPACITY>
+bool FixedStorage<ItemType, CAPACITY>::reserve(int new_capacity, int size)
+{
+	return new_capacity <= CAPACITY;
+}  // end reserve
+
+template<class ItemType, int CAPACITY>
+void FixedStorage<ItemType, CAPACITY>::shrinkToFit(int size)
+{
+}  // end shrinkToFit
+
+template<class ItemType, int CAPACITY>
+void FixedStorage<ItemType, CAPACITY>::makeUnique(int size)
+{
+}  // end makeUnique
+
+template<class ItemType, int CAPACITY>
+void FixedStorage<ItemType, CAPACITY>::clear(int size)
+{
+	std::destroy(data(), data() + size);
+}  // end clear
+
+template<class ItemType, int CAPACITY>
+void FixedStorage<ItemType, CAPACITY>::moveFrom(FixedStorage<ItemType, CAPACITY>& other, int size)
+{
+	relocateItems(other.data(), size, data());
+}  // end moveFrom
+
+// ********* GrowableStorage **************//
+
+template<class ItemType>
+GrowableStorage<ItemType>::GrowableStorage(): items_(nullptr), capacity_(0)
+{
+}  // end default constructor
+
+template<class ItemType>
+GrowableStorage<ItemType>::~GrowableStorage()
+{
+	if (items_)
+	{
+		std::allocator<ItemType>().deallocate(items_, capacity_);
+	}  // end if
+}  // end destructor
+
+template<class ItemType>
+ItemType& GrowableStorage<ItemType>::operator[](int index)
+{
+	return items_[index];
+}  // end operator[]
+
+template<class ItemType>
+const ItemType& GrowableStorage<ItemType>::operator[](int index) const
+{
+	return items_[index];
+}  // end operator[]
+
+template<class ItemType>
+ItemType* GrowableStorage<ItemType>::data()
+{
+	return items_;
+}  // end data
+
+template<class ItemType>
+const ItemType* GrowableStorage<ItemType>::data() const
+{
+	return items_;
+}  // end data
+
+template<class ItemType>
+int GrowableStorage<ItemType>::getCapacity() const
+{
+	return capacity_;
+}  // end getCapacity
+
+template<class ItemType>
+bool GrowableStorage<ItemType>::makeRoom(int size)
+{
+	if (size >= capacity_)
+	{
+		reallocate(std::max(MIN_CAPACITY, 2 * capacity_), size);
+	}  // end if
+	return true;
+}  // end makeRoom
+
+template<class ItemType>
+bool GrowableStorage<ItemType>::reserve(int new_capacity, int size)
+{
+	if (new_capacity > capacity_)
+	{
+		reallocate(new_capacity, size);
+	}  // end if
+	return true;
+}  // end reserve
+
+template<class ItemType>
+void GrowableStorage<ItemType>::shrinkToFit(int size)
+{
+	if (size < capacity_)
+	{
+		reallocate(size, size);
+	}  // end if
+}  // end shrinkToFit
+
+template<class ItemType>
+void GrowableStorage<ItemType>::makeUnique(int size)
+{
+}  // end makeUnique
+
+template<class ItemType>
+void GrowableStorage<ItemType>::clear(int size)
+{
+	std::destroy(data(), data() + size);
+}  // end clear
+
+template<class ItemType>
+void GrowableStorage<ItemType>::moveFrom(GrowableStorage<ItemType>& other, int size)
+{
+	if (items_)
+	{
+		std::allocator<ItemType>().deallocate(items_, capacity_);
+	}  // end if
+	items_ = other.items_;
+	capacity_ = other.capacity_;
+	other.items_ = nullptr;
+	other.capacity_ = 0;
+}  // end moveFrom
+
+template<class ItemType>
+void GrowableStorage<ItemType>::reallocate(int new_capacity, int size)
+{
+	std::allocator<ItemType> allocator;
+	ItemType* new_items = (new_capacity > 0) ? allocator.allocate(new_capacity) : nullptr;
+	if (items_)
+	{
+		relocateItems(items_, size, new_items);
+		allocator.deallocate(items_, capacity_);
+	}  // end if
+	items_ = new_items;
+	capacity_ = new_capacity;
+}  // end reallocate
+
+// ********* SpillStorage **************//
+
+template<class ItemType, int INLINE_CAPACITY>
+SpillStorage<ItemType, INLINE_CAPACITY>::SpillStorage(): heap_(nullptr), capacity_(INLINE_CAPACITY)
+{
+}  // end default constructor
+
+template<class ItemType, int INLINE_CAPACITY>
+SpillStorage<ItemType, INLINE_CAPACITY>::~SpillStorage()
+{
+	if (heap_)
+	{
+		std::allocator<ItemType>().deallocate(heap_, capacity_);
+	}  // end if
+}  // end destructor
+
+template<class ItemType, int INLINE_CAPACITY>
+ItemType& SpillStorage<ItemType, INLINE_CAPACITY>::operator[](int index)
+{
+	return data()[index];
+}  // end operator[]
+
+template<class ItemType, int INLINE_CAPACITY>
+const ItemType& SpillStorage<ItemType, INLINE_CAPACITY>::operator[](int index) const
+{
+	return data()[index];
+}  // end operator[]
+
+template<class ItemType, int INLINE_CAPACITY>
+ItemType* SpillStorage<ItemType, INLINE_CAPACITY>::data()
+{
+	return heap_ ? heap_ : reinterpret_cast<ItemType*>(inline_);
+}  // end data
+
+template<class ItemType, int INLINE_CAPACITY>
+const ItemType* SpillStorage<ItemType, INLINE_CAPACITY>::data() const
+{
+	return heap_ ? heap_ : reinterpret_cast<const ItemType*>(inline_);
+}  // end data
+
+template<class ItemType, int INLINE_CAPACITY>
+int SpillStorage<ItemType, INLINE_CAPACITY>::getCapacity() const
+{
+	return capacity_;
+}  // end getCapacity
+
+template<class ItemType, int INLINE_CAPACITY>
+bool SpillStorage<ItemType, INLINE_CAPACITY>::makeRoom(int size)
+{
+	if (size >= capacity_)
+	{
+		spill(std::max(1, 2 * capacity_), size);
+	}  // end if
+	return true;
+}  // end makeRoom
+
+template<class ItemType, int INLINE_CAPACITY>
+bool SpillStorage<ItemType, INLINE_CAPACITY>::reserve(int new_capacity, int size)
+{
+	if (new_capacity > capacity_)
+	{
+		spill(new_capacity, size);
+	}  // end if
+	return true;
+}  // end reserve
+
+template<class ItemType, int INLINE_CAPACITY>
+void SpillStorage<ItemType, INLINE_CAPACITY>::shrinkToFit(int size)
+{
+	if (!heap_)
+	{
+		return;
+	}  // end if
+
+	if (size <= INLINE_CAPACITY)
+	{
+		// Move back inline and drop the heap array
+		relocateItems(heap_, size, reinterpret_cast<ItemType*>(inline_));
+		std::allocator<ItemType>().deallocate(heap_, capacity_);
+		heap_ = nullptr;
+		capacity_ = INLINE_CAPACITY;
+	}
+	else if (size < capacity_)
+	{
+		spill(size, size);
+	}  // end if
+}  // end shrinkToFit
+
+template<class ItemType, int INLINE_CAPACITY>
+void SpillStorage<ItemType, INLINE_CAPACITY>::makeUnique(int size)
+{
+}  // end makeUnique
+
+template<class ItemType, int INLINE_CAPACITY>
+void SpillStorage<ItemType, INLINE_CAPACITY>::clear(int size)
+{
+	std::destroy(data(), data() + size);
+}  // end clear
+
+template<class ItemType, int INLINE_CAPACITY>
+void SpillStorage<ItemType, INLINE_CAPACITY>::moveFrom(SpillStorage<ItemType, INLINE_CAPACITY>& other, int size)
+{
+	if (other.heap_)
+	{
+		if (heap_)
+		{
+			std::allocator<ItemType>().deallocate(heap_, capacity_);
+		}  // end if
+		heap_ = other.heap_;
+		capacity_ = other.capacity_;
+		other.heap_ = nullptr;
+		other.capacity_ = INLINE_CAPACITY;
+	}
+	else
+	{
+		// Our capacity is never below INLINE_CAPACITY, so the items fit wherever they currently live
+		relocateItems(other.data(), size, data());
+	}  // end if
+}  // end moveFrom
+
+template<class ItemType, int INLINE_CAPACITY>
+void SpillStorage<ItemType, INLINE_CAPACITY>::spill(int new_capacity, int size)
+{
+	std::allocator<ItemType> allocator;
+	ItemType* new_heap = allocator.allocate(new_capacity);
+	relocateItems(data(), size, new_heap);
+	if (heap_)
+	{
+		allocator.deallocate(heap_, capacity_);
+	}  // end if
+	heap_ = new_heap;
+	capacity_ = new_capacity;
+}  // end spill
+
+// ********* CowStorage **************//
+
+template<class ItemType>
+CowStorage<ItemType>::Block::Block(int capacity)
+	: items_(std::allocator<ItemType>().allocate(capacity)), capacity_(capacity), live_(0), snapshots_(0)
+{
+}  // end Block constructor
+
+template<class ItemType>
+CowStorage<ItemType>::Block::~Block()
+{
+	std::destroy(items_, items_ + live_);
+	std::allocator<ItemType>().deallocate(items_, capacity_);
+}  // end Block destructor
+
+template<class ItemType>
+ItemType& CowStorage<ItemType>::operator[](int index)
+{
+	return block_->items_[index];
+}  // end operator[]
+
+template<class ItemType>
+const ItemType& CowStorage<ItemType>::operator[](int index) const
+{
+	return block_->items_[index];
+}  // end operator[]
+
+template<class ItemType>
+ItemType* CowStorage<ItemType>::data()
+{
+	return block_ ? block_->items_ : nullptr;
+}  // end data
+
+template<class ItemType>
+const ItemType* CowStorage<ItemType>::data() const
+{
+	return block_ ? block_->items_ : nullptr;
+}  // end data
+
+template<class ItemType>
+int CowStorage<ItemType>::getCapacity() const
+{
+	return block_ ? block_->capacity_ : 0;
+}  // end getCapacity
+
+template<class ItemType>
+bool CowStorage<ItemType>::makeRoom(int size)
+{
+	if (size >= getCapacity())
+	{
+		reallocate(std::max(MIN_CAPACITY, 2 * getCapacity()), size);
+	}  // end if
+	return true;
+}  // end makeRoom
+
+template<class ItemType>
+bool CowStorage<ItemType>::reserve(int new_capacity, int size)
+{
+	if (new_capacity > getCapacity())
+	{
+		reallocate(new_capacity, size);
+	}  // end if
+	return true;
+}  // end reserve
+
+template<class ItemType>
+void CowStorage<ItemType>::shrinkToFit(int size)
+{
+	if (size < getCapacity())
+	{
+		reallocate(size, size);
+	}  // end if
+}  // end shrinkToFit
+
+template<class ItemType>
+void CowStorage<ItemType>::makeUnique(int size)
+{
+	if (isShared())
+	{
+		reallocate(getCapacity(), size);
+	}  // end if
+}  // end makeUnique
+
+template<class ItemType>
+void CowStorage<ItemType>::clear(int size)
+{
+	if (block_ && !isShared())
+	{
+		std::destroy(block_->items_, block_->items_ + size);
+		block_->live_ = 0;
+	}  // end if
+	// A shared block is left to its snapshots, which destroy it when done
+	block_.reset();
+}  // end clear
+
+template<class ItemType>
+void CowStorage<ItemType>::moveFrom(CowStorage<ItemType>& other, int size)
+{
+	block_ = std::move(other.block_);
+	other.block_.reset();
+}  // end moveFrom
+
+template<class ItemType>
+std::shared_ptr<const typename CowStorage<ItemType>::Block> CowStorage<ItemType>::share(int size)
+{
+	if (!block_)
+	{
+		return nullptr;
+	}  // end if
+
+	// Only this storage writes to the block, and only once it's unique again
+	block_->live_ = size;
+	return block_;
+}  // end share
+
+template<class ItemType>
+bool CowStorage<ItemType>::isShared() const
+{
+	// Acquire pairs with the release in ~BagSnapshot, so a dropped snapshot's reads are done
+	return block_ && block_->snapshots_.load(std::memory_order_acquire) > 0;
+}  // end isShared
+
+template<class ItemType>
+void CowStorage<ItemType>::reallocate(int new_capacity, int size)
+{
+	std::shared_ptr<Block> fresh = (new_capacity > 0) ? std::make_shared<Block>(new_capacity) : nullptr;
+	if (block_)
+	{
+		if (isShared())
+		{
+			// Snapshots still read the old items, so copy them; an emptied bag has none to copy
+			if (fresh)
+			{
+				std::uninitialized_copy(block_->items_, block_->items_ + size, fresh->items_);
+			}  // end if
+		}
+		else
+		{
+			relocateItems(block_->items_, size, fresh ? fresh->items_ : nullptr);
+			block_->live_ = 0;
+		}  // end if
+	}  // end if
+	block_ = std::move(fresh);
+}  // end reallocate
+
+// ********* BagSnapshot **************//
+
+template<class ItemType>
+BagSnapshot<ItemType>::BagSnapshot(): size_(0)
+{
+}  // end default constructor
+
+template<class ItemType>
+BagSnapshot<ItemType>::BagSnapshot(std::shared_ptr<const typename CowStorage<ItemType>::Block> block, int size)
+	: block_(std::move(block)), size_(size)
+{
+	if (block_)
+	{
+		block_->snapshots_.fetch_add(1, std::memory_order_relaxed);
+	}  // end if
+}  // end constructor
+
+template<class ItemType>
+BagSnapshot<ItemType>::BagSnapshot(const BagSnapshot<ItemType>& other)
+	: BagSnapshot(other.block_, other.size_)
+{
+}  // end copy constructor
+
+template<class ItemType>
+BagSnapshot<ItemType>& BagSnapshot<ItemType>::operator=(BagSnapshot<ItemType> other)
+{
+	std::swap(block_, other.block_);
+	std::swap(size_, other.size_);
+	return *this;
+}  // end operator=
+
+template<class ItemType>
+BagSnapshot<ItemType>::~BagSnapshot()
+{
+	if (block_)
+	{
+		block_->snapshots_.fetch_sub(1, std::memory_order_release);
+	}  // end if
+}  // end destructor
+
+template<class ItemType>
+int BagSnapshot<ItemType>::getCurrentSize() const
+{
+	return size_;
+}  // end getCurrentSize
+
+template<class ItemType>
+bool BagSnapshot<ItemType>::isEmpty() const
+{
+	return size_ == 0;
+}  // end isEmpty
+
+template<class ItemType>
+bool BagSnapshot<ItemType>::contains(const ItemType& an_entry) const
+{
+	if constexpr (IsScannable<ItemType>::value)
+	{
+		return scanFind(begin(), size_, an_entry) > -1;
+	}
+	else
+	{
+		return std::find(begin(), end(), an_entry) != end();
+	}  // end if
+}  // end contains
+
+template<class ItemType>
+int BagSnapshot<ItemType>::getFrequencyOf(const ItemType& an_entry) const
+{
+	if constexpr (IsScannable<ItemType>::value)
+	{
+		return scanCount(begin(), size_, an_entry);
+	}
+	else
+	{
+		return static_cast<int>(std::count(begin(), end(), an_entry));
+	}  // end if
+}  // end getFrequencyOf
+
+template<class ItemType>
+const ItemType& BagSnapshot<ItemType>::operator[](int index) const
+{
+	return block_->items_[index];
+}  // end operator[]
+
+template<class ItemType>
+typename BagSnapshot<ItemType>::const_iterator BagSnapshot<ItemType>::begin() const
+{
+	return block_ ? block_->items_ : nullptr;
+}  // end begin
+
+template<class ItemType>
+typename BagSnapshot<ItemType>::const_iterator BagSnapshot<ItemType>::end() const
+{
+	return begin() + size_;
+}  // end end
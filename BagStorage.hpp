@@ -0,0 +1,367 @@
+/*
+Storage policies for ArrayBag.
+Each policy owns the raw, uninitialized memory that backs items_ and decides how
+(or whether) it grows. ArrayBag constructs and destroys the items in it; a policy
+only relocates the first `size` live items when it moves them to new memory.
+*/
+
+#ifndef BAG_STORAGE_
+#define BAG_STORAGE_
+
+#include <atomic>
+#include <memory>
+
+/**
+    Fixed inline array of CAPACITY items. Never allocates; add() fails once full.
+    This is the original ArrayBag behaviour.
+**/
+template <class ItemType, int CAPACITY = 100>
+class FixedStorage
+{
+   public:
+   FixedStorage() = default;
+   FixedStorage(const FixedStorage<ItemType, CAPACITY> &other) = delete;
+   FixedStorage<ItemType, CAPACITY> &operator=(const FixedStorage<ItemType, CAPACITY> &other) = delete;
+
+   /** @return the item at index **/
+   ItemType &operator[](int index);
+   const ItemType &operator[](int index) const;
+
+   /** @return pointer to the first slot **/
+   ItemType *data();
+   const ItemType *data() const;
+
+   /** @return the number of slots available **/
+   int getCapacity() const;
+
+   /**
+       @param size the number of slots currently in use
+       @return true if there is room for one more item past size, false otherwise
+   **/
+   bool makeRoom(int size);
+
+   /**
+       @param new_capacity the requested number of slots
+       @param size the number of slots currently in use
+       @return true if new_capacity slots are available, false otherwise
+   **/
+   bool reserve(int new_capacity, int size);
+
+   /**
+       @param size the number of slots currently in use
+       @post nothing, inline storage cannot shrink
+   **/
+   void shrinkToFit(int size);
+
+   /**
+       @param size the number of slots currently in use
+       @post nothing, this storage is never shared
+   **/
+   void makeUnique(int size);
+
+   /**
+       @param size the number of slots currently in use
+       @post the first size items are destroyed
+   **/
+   void clear(int size);
+
+   /**
+       @pre this storage holds no live items
+       @param other storage holding size live items
+       @post the items are moved into this storage and destroyed in other
+   **/
+   void moveFrom(FixedStorage<ItemType, CAPACITY> &other, int size);
+
+   private:
+   alignas(ItemType) unsigned char slots_[CAPACITY * sizeof(ItemType)];
+}; // end FixedStorage
+
+/**
+    Heap array that doubles when full, so add() is amortized O(1).
+    Allocates nothing until the first item is added.
+**/
+template <class ItemType>
+class GrowableStorage
+{
+   public:
+   GrowableStorage();
+   GrowableStorage(const GrowableStorage<ItemType> &other) = delete;
+   GrowableStorage<ItemType> &operator=(const GrowableStorage<ItemType> &other) = delete;
+   ~GrowableStorage();
+
+   ItemType &operator[](int index);
+   const ItemType &operator[](int index) const;
+
+   ItemType *data();
+   const ItemType *data() const;
+
+   int getCapacity() const;
+
+   /**
+       @param size the number of slots currently in use
+       @post if the array is full, its capacity is doubled
+       @return true
+   **/
+   bool makeRoom(int size);
+
+   /**
+       @param new_capacity the requested number of slots
+       @param size the number of slots currently in use
+       @post if new_capacity exceeds the current capacity, the first size items
+             are moved into a new array of exactly new_capacity slots
+       @return true
+   **/
+   bool reserve(int new_capacity, int size);
+
+   /**
+       @param size the number of slots currently in use
+       @post capacity == size, releasing the array entirely when size == 0
+   **/
+   void shrinkToFit(int size);
+
+   /**
+       @param size the number of slots currently in use
+       @post nothing, this storage is never shared
+   **/
+   void makeUnique(int size);
+
+   /**
+       @param size the number of slots currently in use
+       @post the first size items are destroyed
+   **/
+   void clear(int size);
+
+   /**
+       @pre this storage holds no live items
+       @param other storage holding size live items
+       @post this storage takes over other's array; other is left empty
+   **/
+   void moveFrom(GrowableStorage<ItemType> &other, int size);
+
+   private:
+   static constexpr int MIN_CAPACITY = 8; // first allocation, to skip the 1, 2, 4 steps
+   ItemType *items_;
+   int capacity_;
+
+   /** @post items_ holds exactly new_capacity slots, the first size of them moved over **/
+   void reallocate(int new_capacity, int size);
+}; // end GrowableStorage
+
+/**
+    INLINE_CAPACITY slots stored inline, spilling to a doubling heap array past that.
+    Small bags never allocate; large bags behave like GrowableStorage.
+**/
+template <class ItemType, int INLINE_CAPACITY = 100>
+class SpillStorage
+{
+   public:
+   SpillStorage();
+   SpillStorage(const SpillStorage<ItemType, INLINE_CAPACITY> &other) = delete;
+   SpillStorage<ItemType, INLINE_CAPACITY> &operator=(const SpillStorage<ItemType, INLINE_CAPACITY> &other) = delete;
+   ~SpillStorage();
+
+   ItemType &operator[](int index);
+   const ItemType &operator[](int index) const;
+
+   ItemType *data();
+   const ItemType *data() const;
+
+   int getCapacity() const;
+
+   /**
+       @param size the number of slots currently in use
+       @post if the array is full, its capacity is doubled (spilling to the heap if still inline)
+       @return true
+   **/
+   bool makeRoom(int size);
+
+   /**
+       @param new_capacity the requested number of slots
+       @param size the number of slots currently in use
+       @post if new_capacity exceeds the current capacity, the first size items
+             are moved into a heap array of exactly new_capacity slots
+       @return true
+   **/
+   bool reserve(int new_capacity, int size);
+
+   /**
+       @param size the number of slots currently in use
+       @post moves back inline if size fits, otherwise trims the heap array to size
+   **/
+   void shrinkToFit(int size);
+
+   /**
+       @param size the number of slots currently in use
+       @post nothing, this storage is never shared
+   **/
+   void makeUnique(int size);
+
+   /**
+       @param size the number of slots currently in use
+       @post the first size items are destroyed
+   **/
+   void clear(int size);
+
+   /**
+       @pre this storage holds no live items
+       @param other storage holding size live items
+       @post takes over other's heap array if it has spilled, otherwise moves the
+             items inline; other is left empty and inline
+   **/
+   void moveFrom(SpillStorage<ItemType, INLINE_CAPACITY> &other, int size);
+
+   private:
+   alignas(ItemType) unsigned char inline_[INLINE_CAPACITY * sizeof(ItemType)];
+   ItemType *heap_;  // nullptr while the items live in inline_
+   int capacity_;
+
+   /** @post items live in a heap array of exactly new_capacity slots, the first size of them moved over **/
+   void spill(int new_capacity, int size);
+}; // end SpillStorage
+
+/**
+    Heap array shared, copy-on-write, with any live BagSnapshot taken from the bag.
+    Taking a snapshot is O(1); the array is only copied when the bag is written to
+    while a snapshot still holds it. Writers must call makeUnique() before writing
+    through data() or operator[].
+**/
+template <class ItemType>
+class CowStorage
+{
+   public:
+   /** Reference-counted array, destroying live_ items when its last owner lets go **/
+   struct Block
+   {
+      ItemType *items_;
+      int capacity_;
+      int live_;  // items to destroy with the block; only kept current while shared
+      mutable std::atomic<int> snapshots_;  // BagSnapshots reading the block
+
+      Block(int capacity);
+      Block(const Block &other) = delete;
+      Block &operator=(const Block &other) = delete;
+      ~Block();
+   };
+
+   CowStorage() = default;
+   CowStorage(const CowStorage<ItemType> &other) = delete;
+   CowStorage<ItemType> &operator=(const CowStorage<ItemType> &other) = delete;
+
+   ItemType &operator[](int index);
+   const ItemType &operator[](int index) const;
+
+   ItemType *data();
+   const ItemType *data() const;
+
+   int getCapacity() const;
+
+   /**
+       @param size the number of slots currently in use
+       @post if the array is full, its capacity is doubled
+       @return true
+   **/
+   bool makeRoom(int size);
+
+   /**
+       @param new_capacity the requested number of slots
+       @param size the number of slots currently in use
+       @post if new_capacity exceeds the current capacity, the first size items
+             are moved (or copied, if shared) into a new array of exactly new_capacity slots
+       @return true
+   **/
+   bool reserve(int new_capacity, int size);
+
+   /**
+       @param size the number of slots currently in use
+       @post capacity == size
+   **/
+   void shrinkToFit(int size);
+
+   /**
+       @param size the number of slots currently in use
+       @post the array is owned by this storage alone, copying the first size items if a snapshot shares it
+   **/
+   void makeUnique(int size);
+
+   /**
+       @param size the number of slots currently in use
+       @post this storage holds no items; they are destroyed unless a snapshot still shares them
+   **/
+   void clear(int size);
+
+   /**
+       @pre this storage holds no live items
+       @param other storage holding size live items
+       @post this storage takes over other's array, shared or not; other is left empty
+   **/
+   void moveFrom(CowStorage<ItemType> &other, int size);
+
+   /**
+       @param size the number of slots currently in use
+       @return the array, frozen at its first size items until every holder releases it
+   **/
+   std::shared_ptr<const Block> share(int size);
+
+   private:
+   static constexpr int MIN_CAPACITY = 8;
+   std::shared_ptr<Block> block_;  // nullptr until the first item is added
+
+   /** @return true if a snapshot still reads block_; once false, its reads happen before our writes **/
+   bool isShared() const;
+
+   /** @post block_ is a new array of new_capacity slots holding the first size items **/
+   void reallocate(int new_capacity, int size);
+}; // end CowStorage
+
+/**
+    Immutable view of an ArrayBag<ItemType, CowStorage<ItemType>, ...> as it was when
+    snapshot() was called. Cheap to copy and safe to read from other threads while the
+    bag keeps changing.
+**/
+template <class ItemType>
+class BagSnapshot
+{
+   public:
+   typedef const ItemType *const_iterator;
+   typedef const ItemType *iterator;
+
+   /** empty snapshot **/
+   BagSnapshot();
+
+   /**
+       @param block the shared array
+       @param size the number of items the snapshot sees
+   **/
+   BagSnapshot(std::shared_ptr<const typename CowStorage<ItemType>::Block> block, int size);
+
+   BagSnapshot(const BagSnapshot<ItemType> &other);
+   BagSnapshot<ItemType> &operator=(BagSnapshot<ItemType> other);
+
+   /** @post the bag may write in place again once no other snapshot reads its array **/
+   ~BagSnapshot();
+
+   /** @return the number of items in the snapshot **/
+   int getCurrentSize() const;
+
+   /** @return true if the snapshot holds no items **/
+   bool isEmpty() const;
+
+   /** @return true if an_entry is in the snapshot **/
+   bool contains(const ItemType &an_entry) const;
+
+   /** @return the number of times an_entry is in the snapshot **/
+   int getFrequencyOf(const ItemType &an_entry) const;
+
+   /** @return the item at index **/
+   const ItemType &operator[](int index) const;
+
+   const_iterator begin() const;
+   const_iterator end() const;
+
+   private:
+   std::shared_ptr<const typename CowStorage<ItemType>::Block> block_;
+   int size_;
+}; // end BagSnapshot
+
+#include "BagStorage.cpp"
+#endif
@@ -79,13 +79,9 @@ double Cavern::calculateTamePercentage() const {
               NOTE: no pre-processing of the input string necessary, only uppercase input will match.
 **/
 int Cavern::tallyCategory(const std::string& s) const {
-    size_t sum = 0;
-    for (size_t i = 0; i < ArrayBag<Creature>::getCurrentSize(); i++) {
-        if (ArrayBag<Creature>::items_[i].getCategory() == s) {
-            sum++;
-        }
-    }
-    return sum;
+    return std::count_if(begin(), end(), [&s](const Creature* c) {
+        return c->getCategory() == s;
+    });
 }
 
 /**
@@ -96,15 +92,15 @@ int Cavern::tallyCategory(const std::string& s) const {
 int Cavern::releaseCreaturesBelowLevel(int n) {
     n = std::max(n, 0);
 
-    size_t removed = 0;
-    for (size_t i = 0; i < ArrayBag<Creature>::getCurrentSize();) {
-        if (ArrayBag<Creature>::items_[i].getLevel() < n) {
-            removed += ArrayBag<Creature>::remove(ArrayBag<Creature>::items_[i]);
-        } else {
-            i++;
+    // Single pass; the level sum and tame count are updated as creatures leave
+    return ArrayBag::removeIf([this, n](Creature* c) {
+        if (c->getLevel() >= n) {
+            return false;
         }
-    }
-    return removed;
+        level_sum_ -= c->getLevel();
+        tame_count_ -= c->isTame();
+        return true;
+    });
 }
 
 /**
@@ -115,21 +111,22 @@ int Cavern::releaseCreaturesBelowLevel(int n) {
 */
 int Cavern::releaseCreaturesOfCategory(const std::string& s) {
     if (s == "ALL") {
-        int n = ArrayBag<Creature>::getCurrentSize();
-        ArrayBag<Creature>::clear();
+        int n = ArrayBag::getCurrentSize();
+        ArrayBag::clear();
+        level_sum_ = 0;
+        tame_count_ = 0;
         return n;
     }
 
-    size_t removed = 0;
-    for (size_t i = 0; i < ArrayBag<Creature>::getCurrentSize();) {
-        if (ArrayBag<Creature>::items_[i].getCategory() == s) {
-            removed += ArrayBag<Creature>::remove(ArrayBag<Creature>::items_[i]);
-        } else {
-            i++;
+    // Single pass; the level sum and tame count are updated as creatures leave
+    return ArrayBag::removeIf([this, &s](Creature* c) {
+        if (c->getCategory() != s) {
+            return false;
         }
-    }
-    return removed;
-    
+        level_sum_ -= c->getLevel();
+        tame_count_ -= c->isTame();
+        return true;
+    });
 }
 
 /**
@@ -161,9 +158,9 @@ void Cavern::cavernReport() const {
 @post: For every creature in the cavern, displays each creature's information
 */
 void Cavern::displayCreatures() const {
-    for (size_t i = 0; i < getCurrentSize(); i++) {
-        items_[i]->display();
-    }
+    std::for_each(begin(), end(), [](const Creature* c) {
+        c->display();
+    });
 }
 
 /**
@@ -183,9 +180,10 @@ void Cavern::displayCategory(const std::string& category) const {
 @post: Every creature in the cavern eats a MycoMorsel.
 */
 void Cavern::mycoMorselFeast() {
-    for (size_t i = 0; i < getCurrentSize(); i++) {
-        items_[i]->eatMycoMorsel();
-    }
+    // Sequential on purpose: eating prints, and parallel output would interleave
+    std::for_each(begin(), end(), [](Creature* c) {
+        c->eatMycoMorsel();
+    });
 }
 /*
     @param The category of creature to initialize the stack of
@@ -15,7 +15,9 @@
 #include <sstream>
 #include <string>
 
-class Cavern : public ArrayBag<Creature*>{
+// Inline storage keeps small caverns allocation-free; larger populations spill to the heap.
+// The hash index keeps the membership check in enterCavern O(1).
+class Cavern : public ArrayBag<Creature*, SpillStorage<Creature*>, HashIndex<Creature*>> {
     public: 
       /**
           Default constructor.
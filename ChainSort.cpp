@@ -0,0 +1,128 @@
+/*
+Stable bottom-up merge sort for singly linked chains of nodes.
+*/
+
+#include "ChainSort.hpp"
+
+template <class NodePtr, class GetNext, class SetNext, class Less>
+NodePtr sortChain(NodePtr head, GetNext get_next, SetNext set_next, Less less, NodePtr& tail)
+{
+	tail = nullptr;
+	if (head == nullptr)
+	{
+		return head;
+	}  // end if
+
+	// Merge runs of run_size into runs of 2 * run_size until a pass does a single merge
+	for (int run_size = 1; ; run_size *= 2)
+	{
+		NodePtr left = head;
+		head = nullptr;
+		tail = nullptr;
+		int merges = 0;
+
+		while (left != nullptr)
+		{
+			merges++;
+
+			// The right run starts run_size nodes after the left one
+			NodePtr right = left;
+			int left_size = 0;
+			while (left_size < run_size && right != nullptr)
+			{
+				left_size++;
+				right = get_next(right);
+			}  // end while
+			int right_size = run_size;
+
+			while (left_size > 0 || (right_size > 0 && right != nullptr))
+			{
+				// Take from the left run unless the right one is strictly smaller, for stability
+				NodePtr next;
+				if (left_size == 0)
+				{
+					next = right;
+					right = get_next(right);
+					right_size--;
+				}
+				else if (right_size == 0 || right == nullptr || !less(right, left))
+				{
+					next = left;
+					left = get_next(left);
+					left_size--;
+				}
+				else
+				{
+					next = right;
+					right = get_next(right);
+					right_size--;
+				}  // end if
+
+				if (tail != nullptr)
+				{
+					set_next(tail, next);
+				}
+				else
+				{
+					head = next;
+				}  // end if
+				tail = next;
+			}  // end while
+
+			left = right;
+		}  // end while
+
+		set_next(tail, nullptr);
+		if (merges <= 1)
+		{
+			return head;
+		}  // end if
+	}  // end for
+}  // end sortChain
+
+template <class NodePtr, class GetNext, class SetNext, class Less>
+NodePtr mergeChains(NodePtr first, NodePtr second, GetNext get_next, SetNext set_next, Less less, NodePtr& tail)
+{
+	NodePtr head = nullptr;
+	tail = nullptr;
+	while (first != nullptr || second != nullptr)
+	{
+		NodePtr next;
+		if (second == nullptr || (first != nullptr && !less(second, first)))
+		{
+			next = first;
+			first = get_next(first);
+		}
+		else
+		{
+			next = second;
+			second = get_next(second);
+		}  // end if
+
+		if (tail != nullptr)
+		{
+			set_next(tail, next);
+		}
+		else
+		{
+			head = next;
+		}  // end if
+		tail = next;
+
+		// Once one chain runs out the rest of the other is already in order and linked
+		if (first == nullptr || second == nullptr)
+		{
+			NodePtr rest = (first != nullptr) ? first : second;
+			if (rest != nullptr)
+			{
+				set_next(tail, rest);
+				while (get_next(tail) != nullptr)
+				{
+					tail = get_next(tail);
+				}  // end while
+			}  // end if
+			return head;
+		}  // end if
+	}  // end while
+	return head;
+}  // end mergeChains
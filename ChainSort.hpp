@@ -0,0 +1,32 @@
+/*
+Stable bottom-up merge sort for singly linked chains of nodes.
+Shared by the list classes; it only relinks nodes, so it never allocates or copies items.
+*/
+
+#ifndef CHAIN_SORT_
+#define CHAIN_SORT_
+
+/**
+    @param head the first node of a nullptr-terminated chain (may be nullptr)
+    @param get_next callable returning a node's successor
+    @param set_next callable setting a node's successor
+    @param less strict weak ordering on nodes
+    @param tail set to the last node of the sorted chain (nullptr if empty)
+    @post the chain is relinked in stable sorted order in O(n log n) time and O(1) space
+    @return the first node of the sorted chain
+**/
+template <class NodePtr, class GetNext, class SetNext, class Less>
+NodePtr sortChain(NodePtr head, GetNext get_next, SetNext set_next, Less less, NodePtr &tail);
+
+/**
+    @param first the first node of a sorted, nullptr-terminated chain
+    @param second the first node of another sorted, nullptr-terminated chain
+    @param tail set to the last node of the merged chain (nullptr if both are empty)
+    @post the chains are relinked into one sorted chain; on ties nodes of first come first
+    @return the first node of the merged chain
+**/
+template <class NodePtr, class GetNext, class SetNext, class Less>
+NodePtr mergeChains(NodePtr first, NodePtr second, GetNext get_next, SetNext set_next, Less less, NodePtr &tail);
+
+#include "ChainSort.cpp"
+#endif
@@ -0,0 +1,204 @@
+/*
+Append-only bag that many threads can add to at once without a lock.
+*/
+
+#include "ConcurrentBag.hpp"
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <utility>
+
+/** default constructor**/
+template<class ItemType>
+ConcurrentBag<ItemType>::ConcurrentBag(): item_count_(0)
+{
+	for (int k = 0; k < MAX_SEGMENTS; k++)
+	{
+		segments_[k].store(nullptr, std::memory_order_relaxed);
+	}  // end for
+}  // end default constructor
+
+/** destructor: destroys every item and releases every segment **/
+template<class ItemType>
+ConcurrentBag<ItemType>::~ConcurrentBag()
+{
+	release();
+}  // end destructor
+
+/**
+ @return the number of slots claimed so far, which may include adds still in progress
+         and adds whose item threw while being constructed
+ **/
+template<class ItemType>
+int ConcurrentBag<ItemType>::getCurrentSize() const
+{
+	return std::min(item_count_.load(std::memory_order_acquire), MAX_ITEMS);
+}  // end getCurrentSize
+
+/**
+ @return true if no item has been added, false otherwise
+ **/
+template<class ItemType>
+bool ConcurrentBag<ItemType>::isEmpty() const
+{
+	return getCurrentSize() == 0;
+}  // end isEmpty
+
+/**
+ Safe to call from any number of threads at once. If copying or moving new_entry
+ throws, the exception propagates and the slot it claimed stays empty.
+ @return true if new_entry was successfully added, false if the bag is full
+ **/
+template<class ItemType>
+bool ConcurrentBag<ItemType>::add(const ItemType& new_entry)
+{
+	return addEntry(new_entry);
+}  // end add
+
+template<class ItemType>
+bool ConcurrentBag<ItemType>::add(ItemType&& new_entry)
+{
+	return addEntry(std::move(new_entry));
+}  // end add
+
+/**
+ @pre no add() is in progress (e.g. every producer thread has been joined)
+ @post every item has been moved into the returned bag; this bag is empty and can be reused
+ @return a plain, single-threaded bag holding the items
+ **/
+template<class ItemType>
+template<class Bag>
+Bag ConcurrentBag<ItemType>::freeze()
+{
+	int count = getCurrentSize();
+	Bag frozen;
+	frozen.reserve(count);
+
+	// Walk the segments in slot order so the bag sees items in the order they were claimed
+	int index = 0;
+	for (int k = 0; index < count; k++)
+	{
+		Slot* segment = segments_[k].load(std::memory_order_acquire);
+		int segment_size = FIRST_SEGMENT_SIZE << k;
+		if (!segment)
+		{
+			// Allocating it threw, so none of its slots were filled
+			index += segment_size;
+			continue;
+		}  // end if
+		for (int offset = 0; offset < segment_size && index < count; offset++, index++)
+		{
+			if (segment[offset].filled_)
+			{
+				frozen.add(std::move(*itemOf(segment[offset])));
+			}  // end if
+		}  // end for
+	}  // end for
+
+	release();
+	return frozen;
+}  // end freeze
+
+// ********* PRIVATE METHODS **************//
+
+/**
+ @param index a slot number < MAX_ITEMS
+ @param offset set to the position of index within its segment
+ @return the segment holding index
+ **/
+template<class ItemType>
+int ConcurrentBag<ItemType>::segmentOf(int index, int& offset)
+{
+	// Segment k starts at slot FIRST_SEGMENT_SIZE * (2^k - 1)
+	int k = 31 - __builtin_clz(static_cast<unsigned>(index / FIRST_SEGMENT_SIZE + 1));
+	offset = index - FIRST_SEGMENT_SIZE * ((1 << k) - 1);
+	return k;
+}  // end segmentOf
+
+/**
+ @pre slot.filled_
+ @return the item in slot
+ **/
+template<class ItemType>
+ItemType* ConcurrentBag<ItemType>::itemOf(Slot& slot)
+{
+	return std::launder(reinterpret_cast<ItemType*>(slot.storage_));
+}  // end itemOf
+
+/**
+ @return segment k, allocating it with every slot empty if no thread has yet
+ **/
+template<class ItemType>
+typename ConcurrentBag<ItemType>::Slot* ConcurrentBag<ItemType>::getSegment(int k)
+{
+	Slot* segment = segments_[k].load(std::memory_order_acquire);
+	if (segment)
+	{
+		return segment;
+	}  // end if
+
+	// Several threads may race to allocate the same segment; the losers free theirs
+	std::allocator<Slot> allocator;
+	Slot* fresh = allocator.allocate(FIRST_SEGMENT_SIZE << k);
+	for (int offset = 0; offset < (FIRST_SEGMENT_SIZE << k); offset++)
+	{
+		fresh[offset].filled_ = false;
+	}  // end for
+	if (segments_[k].compare_exchange_strong(segment, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+	{
+		return fresh;
+	}  // end if
+	allocator.deallocate(fresh, FIRST_SEGMENT_SIZE << k);
+	return segment;
+}  // end getSegment
+
+/**
+ @post every item in a filled slot is destroyed and every segment released
+ **/
+template<class ItemType>
+void ConcurrentBag<ItemType>::release()
+{
+	int count = getCurrentSize();
+	int index = 0;
+	std::allocator<Slot> allocator;
+	for (int k = 0; k < MAX_SEGMENTS; k++)
+	{
+		Slot* segment = segments_[k].load(std::memory_order_acquire);
+		int segment_size = FIRST_SEGMENT_SIZE << k;
+		if (segment)
+		{
+			int claimed = std::max(0, std::min(segment_size, count - index));
+			for (int offset = 0; offset < claimed; offset++)
+			{
+				if (segment[offset].filled_)
+				{
+					std::destroy_at(itemOf(segment[offset]));
+				}  // end if
+			}  // end for
+			allocator.deallocate(segment, segment_size);
+			segments_[k].store(nullptr, std::memory_order_relaxed);
+		}  // end if
+		index += segment_size;
+	}  // end for
+	item_count_.store(0, std::memory_order_release);
+}  // end release
+
+template<class ItemType>
+template<class Entry>
+bool ConcurrentBag<ItemType>::addEntry(Entry&& new_entry)
+{
+	int index = item_count_.fetch_add(1, std::memory_order_acq_rel);
+	if (index >= MAX_ITEMS || index < 0)
+	{
+		// Leave the counter pinned past the end so later adds fail too
+		return false;
+	}  // end if
+
+	// If either step throws, the slot is left empty and skipped by freeze and release
+	int offset;
+	int k = segmentOf(index, offset);
+	Slot& slot = getSegment(k)[offset];
+	::new (static_cast<void*>(slot.storage_)) ItemType(std::forward<Entry>(new_entry));
+	slot.filled_ = true;
+	return true;
+}  // end addEntry
@@ -0,0 +1,99 @@
+/*
+Append-only bag that many threads can add to at once without a lock.
+Used to ingest items in parallel before handing them to an ArrayBag.
+*/
+
+#ifndef CONCURRENT_BAG_
+#define CONCURRENT_BAG_
+
+#include <atomic>
+#include "ArrayBag.hpp"
+
+/**
+    Items live in segments of doubling size (64, 128, 256, ...) that are allocated on
+    first use and never move, so add() only needs an atomic fetch-add to claim a slot.
+**/
+template <class ItemType>
+class ConcurrentBag
+{
+   public:
+   /** default constructor**/
+   ConcurrentBag();
+
+   ConcurrentBag(const ConcurrentBag<ItemType> &other) = delete;
+   ConcurrentBag<ItemType> &operator=(const ConcurrentBag<ItemType> &other) = delete;
+
+   /** destructor: destroys every item and releases every segment **/
+   ~ConcurrentBag();
+
+   /**
+       @return the number of slots claimed so far, which may include adds still in progress
+               and adds whose item threw while being constructed
+   **/
+   int getCurrentSize() const;
+
+   /**
+       @return true if no item has been added, false otherwise
+   **/
+   bool isEmpty() const;
+
+   /**
+       Safe to call from any number of threads at once. If copying or moving new_entry
+       throws, the exception propagates and the slot it claimed stays empty.
+       @return true if new_entry was successfully added, false if the bag is full
+   **/
+   bool add(const ItemType &new_entry);
+   bool add(ItemType &&new_entry);
+
+   /**
+       @pre no add() is in progress (e.g. every producer thread has been joined)
+       @post every item has been moved into the returned bag; this bag is empty and can be reused
+       @return a plain, single-threaded bag holding the items
+   **/
+   template <class Bag = ArrayBag<ItemType, GrowableStorage<ItemType>>>
+   Bag freeze();
+
+   private:
+   static constexpr int FIRST_SEGMENT_SIZE = 64;
+   static constexpr int MAX_SEGMENTS = 25;   // 64 * (2^25 - 1) slots, just under INT_MAX
+   static constexpr int MAX_ITEMS = FIRST_SEGMENT_SIZE * ((1 << MAX_SEGMENTS) - 1);
+
+   /** Room for one item, which is only there once filled_ is set **/
+   struct Slot
+   {
+      alignas(ItemType) unsigned char storage_[sizeof(ItemType)];
+      bool filled_;  // false until the item is constructed, and for good if that threw
+   };
+
+   std::atomic<int> item_count_;                 // slots claimed so far
+   std::atomic<Slot *> segments_[MAX_SEGMENTS];  // nullptr until first used
+
+   /**
+       @pre slot.filled_
+       @return the item in slot
+   **/
+   static ItemType *itemOf(Slot &slot);
+
+   /**
+       @param index a slot number < MAX_ITEMS
+       @param offset set to the position of index within its segment
+       @return the segment holding index
+   **/
+   static int segmentOf(int index, int &offset);
+
+   /**
+       @return segment k, allocating it with every slot empty if no thread has yet
+   **/
+   Slot *getSegment(int k);
+
+   /**
+       @post every item in a filled slot is destroyed and every segment released
+   **/
+   void release();
+
+   template <class Entry>
+   bool addEntry(Entry &&new_entry);
+}; // end ConcurrentBag
+
+#include "ConcurrentBag.cpp"
+#endif
@@ -0,0 +1,66 @@
+/*
+Contention benchmark for ConcurrentBag.
+Producer threads add 8M ints in total, split evenly, to a ConcurrentBag and then to an
+ArrayBag guarded by a std::mutex, for 1, 2, 4 and 8 threads.
+Build and run with `make concurrentbag_bench && ./concurrentbag_bench`.
+*/
+
+#include "ConcurrentBag.hpp"
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+static const int TOTAL_ITEMS = 8000000;
+
+/*
+    @param threads how many producers to run
+    @param produce called as produce(first, last) on each producer thread
+    @return seconds until every producer has finished
+*/
+template<class Produce>
+static double timeProducers(int threads, Produce produce)
+{
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::thread> producers;
+	for (int t = 0; t < threads; t++)
+	{
+		producers.emplace_back(produce, TOTAL_ITEMS / threads * t, TOTAL_ITEMS / threads * (t + 1));
+	}  // end for
+	for (std::thread& producer : producers)
+	{
+		producer.join();
+	}  // end for
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main()
+{
+	std::printf("%d hardware threads\n", static_cast<int>(std::thread::hardware_concurrency()));
+	for (int threads : { 1, 2, 4, 8 })
+	{
+		ConcurrentBag<int> lock_free;
+		double lock_free_seconds = timeProducers(threads, [&](int first, int last) {
+			for (int i = first; i < last; i++)
+			{
+				lock_free.add(i);
+			}  // end for
+		});
+
+		ArrayBag<int, GrowableStorage<int>> locked;
+		std::mutex lock;
+		double locked_seconds = timeProducers(threads, [&](int first, int last) {
+			for (int i = first; i < last; i++)
+			{
+				std::lock_guard<std::mutex> guard(lock);
+				locked.add(i);
+			}  // end for
+		});
+
+		std::printf("%d threads: ConcurrentBag %6.1f Mops/s, mutex + ArrayBag %6.1f Mops/s (%d / %d items)\n",
+			threads, TOTAL_ITEMS / lock_free_seconds / 1e6, TOTAL_ITEMS / locked_seconds / 1e6,
+			lock_free.getCurrentSize(), locked.getCurrentSize());
+	}  // end for
+	return 0;
+}
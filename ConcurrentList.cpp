@@ -0,0 +1,584 @@
+/** Lock-free linked list.
+
+ Implementation file for the class ConcurrentList.
+ @file ConcurrentList.cpp */
+
+#include "ConcurrentList.hpp"  // Header file
+#include <new>
+#include <string>
+#include <utility>
+
+// constructor
+template<class T>
+ConcurrentList<T>::ConcurrentList() : head_(0), item_count_(0), tail_hint_(nullptr)
+{
+}  // end default constructor
+
+
+// copy constructor
+template<class T>
+ConcurrentList<T>::ConcurrentList(const ConcurrentList<T>& a_list) : ConcurrentList()
+{
+   // Nobody else can see this list yet, so link the copies straight onto the tail
+   Link* tail_link = &head_;
+   ListNode* tail_ptr = nullptr;
+   int count = 0;
+   for (const T& item : a_list)
+   {
+      tail_ptr = new ListNode(item);
+      tail_link->store(reinterpret_cast<std::uintptr_t>(tail_ptr), std::memory_order_relaxed);
+      tail_link = &tail_ptr->next_;
+      count++;
+   }  // end for
+   tail_hint_.store(tail_ptr, std::memory_order_relaxed);
+   item_count_.store(count, std::memory_order_release);
+}  // end copy constructor
+
+
+// destructor
+template<class T>
+ConcurrentList<T>::~ConcurrentList()
+{
+   // Marked nodes that were never unlinked are still on the chain; retired ones are the domain's
+   ListNode* cur_ptr = nodeOf(head_.load(std::memory_order_acquire));
+   while (cur_ptr != nullptr)
+   {
+      ListNode* next_ptr = nodeOf(cur_ptr->next_.load(std::memory_order_relaxed));
+      delete cur_ptr;
+      cur_ptr = next_ptr;
+   }  // end while
+}  // end destructor
+
+
+
+/**@return true if list is empty - item_count_ == 0 */
+template<class T>
+bool ConcurrentList<T>::isEmpty() const
+{
+   return getLength() == 0;
+}  // end isEmpty
+
+
+/**@return the number of items in the list - item_count_, exact once updates have finished */
+template<class T>
+int ConcurrentList<T>::getLength() const
+{
+   return item_count_.load(std::memory_order_acquire);
+}  // end getLength
+
+
+
+/**
+ @pre list positions follow traditional indexing from 0 to item_count_ -1
+ @param position indicating point of insertion
+ @param new_entry to be inserted in list
+ @post new_entry is added at position in list (the item previously at that position is now at position+1)
+ @return true if valid position (0 <= position <= item_count_) */
+template<class T>
+bool ConcurrentList<T>::insert(int position, const T& new_entry)
+{
+   return emplace(position, new_entry);
+}  // end insert
+
+template<class T>
+bool ConcurrentList<T>::insert(int position, T&& new_entry)
+{
+   return emplace(position, std::move(new_entry));
+}  // end insert
+
+
+
+/**
+ @pre list positions follow traditional indexing from 0 to item_count_ -1
+ @param position indicating point of insertion
+ @param args arguments for T's constructor
+ @post an item built in place from args is added at position in list
+ @return true if valid position (0 <= position <= item_count_) */
+template<class T>
+template<class... Args>
+bool ConcurrentList<T>::emplace(int position, Args&&... args)
+{
+   if (position < 0)
+      return false;
+   return linkNode(position, new ListNode(std::forward<Args>(args)...));
+}  // end emplace
+
+
+
+/**
+ @param new_entry to be inserted in list
+ @post new_entry is added at the end of the list */
+template<class T>
+void ConcurrentList<T>::push_back(const T& new_entry)
+{
+   linkNode(END, new ListNode(new_entry));
+}  // end push_back
+
+template<class T>
+void ConcurrentList<T>::push_back(T&& new_entry)
+{
+   linkNode(END, new ListNode(std::move(new_entry)));
+}  // end push_back
+
+
+
+/**
+ @param new_entry to be inserted in list
+ @post new_entry is added at the beginning of the list */
+template<class T>
+void ConcurrentList<T>::push_front(const T& new_entry)
+{
+   linkNode(0, new ListNode(new_entry));
+}  // end push_front
+
+template<class T>
+void ConcurrentList<T>::push_front(T&& new_entry)
+{
+   linkNode(0, new ListNode(std::move(new_entry)));
+}  // end push_front
+
+
+
+/**
+ @pre list positions follow traditional indexing from 0 to item_count_ -1
+ @param position indicating point of deletion
+ @post item at position is deleted, if any. List order is retained
+ @return true if there is an item at position to be deleted, false otherwise */
+template<class T>
+bool ConcurrentList<T>::remove(int position)
+{
+   if (position < 0)
+      return false;
+
+   typename Domain::Guard guard(domain_);
+   Link* pred_link;
+   ListNode* cur_ptr;
+   for (;;)
+   {
+      if (!findNode(position, pred_link, cur_ptr) || cur_ptr == nullptr)
+         return false;
+
+      // Marking the link is the removal; whoever marks it first owns the node
+      std::uintptr_t next = cur_ptr->next_.load(std::memory_order_acquire);
+      if (isMarked(next) || !cur_ptr->next_.compare_exchange_strong(next, next | 1, std::memory_order_acq_rel))
+         continue;
+      item_count_.fetch_sub(1, std::memory_order_acq_rel);
+
+      std::uintptr_t expected = reinterpret_cast<std::uintptr_t>(cur_ptr);
+      if (pred_link->compare_exchange_strong(expected, next, std::memory_order_acq_rel))
+         retireNode(cur_ptr);
+      else
+         findNode(position, pred_link, cur_ptr);  // The predecessor changed; the walk unlinks the node
+      return true;
+   }  // end for
+}  // end remove
+
+
+
+/**
+ @param an_entry the item to look for
+ @return true if an item equal to an_entry is in the list */
+template<class T>
+bool ConcurrentList<T>::contains(const T& an_entry) const
+{
+   for (const T& item : *this)
+   {
+      if (item == an_entry)
+         return true;
+   }  // end for
+   return false;
+}  // end contains
+
+
+
+/**@post the list is empty and item_count_ == 0, except for items other threads add meanwhile */
+template<class T>
+void ConcurrentList<T>::clear()
+{
+   while (remove(0))
+   {
+   }  // end while
+}  // end clear
+
+
+
+/**
+ @pre no other thread is using the list
+ @param comp strict weak ordering on items
+ @post the items are in stable sorted order, relinking the existing nodes in O(n log n) */
+template<class T>
+template<class Compare>
+void ConcurrentList<T>::sort(Compare comp)
+{
+   // Drop nodes that were marked but never unlinked, so the chain holds only live items
+   {
+      typename Domain::Guard guard(domain_);
+      Link* pred_link;
+      ListNode* cur_ptr;
+      findNode(END, pred_link, cur_ptr);
+   }
+
+   ListNode* tail_ptr;
+   ListNode* first_ptr = sortChain(nodeOf(head_.load(std::memory_order_acquire)),
+                                   [](ListNode* node_ptr) { return nodeOf(node_ptr->next_.load(std::memory_order_relaxed)); },
+                                   [](ListNode* node_ptr, ListNode* next_ptr)
+                                   { node_ptr->next_.store(reinterpret_cast<std::uintptr_t>(next_ptr), std::memory_order_relaxed); },
+                                   [&comp](ListNode* lhs, ListNode* rhs) { return comp(lhs->item_, rhs->item_); },
+                                   tail_ptr);
+   tail_hint_.store(tail_ptr, std::memory_order_relaxed);
+   head_.store(reinterpret_cast<std::uintptr_t>(first_ptr), std::memory_order_release);
+}  // end sort
+
+
+
+/**
+ @pre list positions follow traditional indexing from 0 to item_count_ -1
+ @param position indicating the position of the data to be retrieved
+ @return a copy of the item found at position. If position is not a valid position < item_count_
+ throws  PrecondViolatedExcep */
+template<class T>
+T ConcurrentList<T>::getEntry(int position) const
+{
+   // Enforce precondition
+   if (position >= 0)
+   {
+      typename Domain::Guard guard(domain_);
+      Link* pred_link;
+      ListNode* cur_ptr;
+      if (findNode(position, pred_link, cur_ptr) && cur_ptr != nullptr)
+         return cur_ptr->item_;
+   }  // end if
+
+   std::string message = "getEntry() called with an empty list or ";
+   message  = message + "invalid position.";
+   throw(PrecondViolatedExcep(message));
+}  // end getEntry
+
+
+
+/**
+ @param position indicating the position of the data to be retrieved
+ @return a pointer to the item at position, or nullptr if position is not a valid
+ position < item_count_. Never throws. */
+template<class T>
+T* ConcurrentList<T>::tryGetEntry(int position)
+{
+   const ConcurrentList<T>& self = *this;
+   return const_cast<T*>(self.tryGetEntry(position));
+}  // end tryGetEntry
+
+template<class T>
+const T* ConcurrentList<T>::tryGetEntry(int position) const
+{
+   if (position < 0)
+      return nullptr;
+
+   typename Domain::Guard guard(domain_);
+   Link* pred_link;
+   ListNode* cur_ptr;
+   if (findNode(position, pred_link, cur_ptr) && cur_ptr != nullptr)
+      return &cur_ptr->item_;
+   return nullptr;
+}  // end tryGetEntry
+
+
+/**@return iterator to the first item */
+template<class T>
+typename ConcurrentList<T>::iterator ConcurrentList<T>::begin()
+{
+   // Pin the epoch before reading the head, so nothing read from here on is reclaimed
+   typename Domain::Guard guard(domain_);
+   ListNode* first_ptr = firstLive(nodeOf(head_.load(std::memory_order_acquire)));
+   return iterator(std::move(guard), first_ptr);
+}  // end begin
+
+template<class T>
+typename ConcurrentList<T>::const_iterator ConcurrentList<T>::begin() const
+{
+   typename Domain::Guard guard(domain_);
+   ListNode* first_ptr = firstLive(nodeOf(head_.load(std::memory_order_acquire)));
+   return const_iterator(std::move(guard), first_ptr);
+}  // end begin
+
+
+/**@return iterator past the last item */
+template<class T>
+typename ConcurrentList<T>::iterator ConcurrentList<T>::end()
+{
+   return iterator();
+}  // end end
+
+template<class T>
+typename ConcurrentList<T>::const_iterator ConcurrentList<T>::end() const
+{
+   return const_iterator();
+}  // end end
+
+
+
+/************* PROTECTED METHODS ************/
+
+
+// @return  the node held by a link, without its mark
+template<class T>
+typename ConcurrentList<T>::ListNode* ConcurrentList<T>::nodeOf(std::uintptr_t link)
+{
+   return reinterpret_cast<ListNode*>(link & ~std::uintptr_t(1));
+}  // end nodeOf
+
+
+// @return  true if the node owning a link has been deleted
+template<class T>
+bool ConcurrentList<T>::isMarked(std::uintptr_t link)
+{
+   return (link & 1) != 0;
+}  // end isMarked
+
+
+// @return  the first node from node_ptr on that is not marked, or nullptr
+template<class T>
+typename ConcurrentList<T>::ListNode* ConcurrentList<T>::firstLive(ListNode* node_ptr)
+{
+   while (node_ptr != nullptr)
+   {
+      std::uintptr_t next = node_ptr->next_.load(std::memory_order_acquire);
+      if (!isMarked(next))
+         return node_ptr;
+      node_ptr = nodeOf(next);
+   }  // end while
+   return nullptr;
+}  // end firstLive
+
+
+// Walks to a position, unlinking and retiring any marked node on the way.
+template<class T>
+bool ConcurrentList<T>::findNode(int position, Link*& pred_link, ListNode*& cur_ptr) const
+{
+retry:
+   pred_link = &head_;
+   cur_ptr = nodeOf(pred_link->load(std::memory_order_acquire));
+   int index = 0;
+   while (cur_ptr != nullptr)
+   {
+      std::uintptr_t next = cur_ptr->next_.load(std::memory_order_acquire);
+      if (isMarked(next))
+      {
+         // Finish the removal; if the predecessor changed meanwhile, start over
+         std::uintptr_t expected = reinterpret_cast<std::uintptr_t>(cur_ptr);
+         if (!pred_link->compare_exchange_strong(expected, next & ~std::uintptr_t(1), std::memory_order_acq_rel))
+            goto retry;
+         retireNode(cur_ptr);
+         cur_ptr = nodeOf(next);
+         continue;
+      }  // end if
+
+      if (index == position)
+         return true;
+      index++;
+      pred_link = &cur_ptr->next_;
+      cur_ptr = nodeOf(next);
+   }  // end while
+
+   return position == END || position == index;
+}  // end findNode
+
+
+// @post new_node_ptr is linked in at position, or deleted if position is not valid
+template<class T>
+bool ConcurrentList<T>::linkNode(int position, ListNode* new_node_ptr)
+{
+   typename Domain::Guard guard(domain_);
+   ListNode* hint_ptr = tail_hint_.load(std::memory_order_acquire);
+   if (position == END)
+   {
+      // Appending after a node only succeeds while it is the last node and not removed.
+      // If other appends got there first, follow them from the hint.
+      ListNode* last_ptr = hint_ptr;
+      while (last_ptr != nullptr)
+      {
+         std::uintptr_t next = 0;
+         if (last_ptr->next_.compare_exchange_strong(next, reinterpret_cast<std::uintptr_t>(new_node_ptr), std::memory_order_acq_rel))
+         {
+            item_count_.fetch_add(1, std::memory_order_acq_rel);
+            publishTail(hint_ptr, new_node_ptr);
+            return true;
+         }  // end if
+         last_ptr = isMarked(next) ? nullptr : nodeOf(next);
+      }  // end while
+   }  // end if
+
+   // There was no hint, it led to a removed node, or the position is not the end,
+   // so walk from the head
+   Link* pred_link;
+   ListNode* cur_ptr;
+   for (;;)
+   {
+      if (!findNode(position, pred_link, cur_ptr))
+      {
+         delete new_node_ptr;
+         return false;
+      }  // end if
+
+      // Fails if the predecessor was marked or another node went in first
+      std::uintptr_t expected = reinterpret_cast<std::uintptr_t>(cur_ptr);
+      new_node_ptr->next_.store(expected, std::memory_order_relaxed);
+      if (pred_link->compare_exchange_strong(expected, reinterpret_cast<std::uintptr_t>(new_node_ptr), std::memory_order_acq_rel))
+      {
+         item_count_.fetch_add(1, std::memory_order_acq_rel);
+         if (cur_ptr == nullptr)
+            publishTail(hint_ptr, new_node_ptr);
+         return true;
+      }  // end if
+   }  // end for
+}  // end linkNode
+
+
+// @post the tail hint is node_ptr, unless the hint changed since or node_ptr was removed
+template<class T>
+void ConcurrentList<T>::publishTail(ListNode* seen_ptr, ListNode* node_ptr)
+{
+   if (!tail_hint_.compare_exchange_strong(seen_ptr, node_ptr, std::memory_order_acq_rel))
+      return;
+
+   // A remover either sees the new hint in retireNode and withdraws it, or marked node_ptr
+   // before this check. In the second case node_ptr may already be retired, so withdraw
+   // it here; EpochDomain keeps it alive for readers of the hint until this guard ends.
+   std::atomic_thread_fence(std::memory_order_seq_cst);
+   if (isMarked(node_ptr->next_.load(std::memory_order_relaxed)))
+      tail_hint_.compare_exchange_strong(node_ptr, nullptr, std::memory_order_acq_rel);
+}  // end publishTail
+
+
+// @post node_ptr is no longer the tail hint, and is left to domain_ to delete
+template<class T>
+void ConcurrentList<T>::retireNode(ListNode* node_ptr) const
+{
+   std::atomic_thread_fence(std::memory_order_seq_cst);
+   ListNode* expected = node_ptr;
+   tail_hint_.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel);
+   domain_.retire(node_ptr);
+}  // end retireNode
+
+
+
+/************* NODE ************/
+
+
+template<class T>
+template<class... Args>
+ConcurrentList<T>::ListNode::ListNode(Args&&... args)
+   : next_(0), retired_next_(nullptr), item_(std::forward<Args>(args)...)
+{
+}  // end constructor
+
+
+
+/************* ITERATOR ************/
+
+
+template<class T>
+ConcurrentList<T>::const_iterator::const_iterator() : guard_(), node_ptr_(nullptr)
+{
+}  // end constructor
+
+template<class T>
+ConcurrentList<T>::const_iterator::const_iterator(typename Domain::Guard guard, ListNode* node_ptr)
+   : guard_(std::move(guard)), node_ptr_(node_ptr)
+{
+}  // end constructor
+
+template<class T>
+const T& ConcurrentList<T>::const_iterator::operator*() const
+{
+   return node_ptr_->item_;
+}  // end operator*
+
+template<class T>
+const T* ConcurrentList<T>::const_iterator::operator->() const
+{
+   return &node_ptr_->item_;
+}  // end operator->
+
+template<class T>
+typename ConcurrentList<T>::const_iterator& ConcurrentList<T>::const_iterator::operator++()
+{
+   node_ptr_ = firstLive(nodeOf(node_ptr_->next_.load(std::memory_order_acquire)));
+   return *this;
+}  // end operator++
+
+template<class T>
+typename ConcurrentList<T>::const_iterator ConcurrentList<T>::const_iterator::operator++(int)
+{
+   const_iterator old = *this;
+   ++(*this);
+   return old;
+}  // end operator++
+
+template<class T>
+bool ConcurrentList<T>::const_iterator::operator==(const const_iterator& rhs) const
+{
+   return node_ptr_ == rhs.node_ptr_;
+}  // end operator==
+
+template<class T>
+bool ConcurrentList<T>::const_iterator::operator!=(const const_iterator& rhs) const
+{
+   return node_ptr_ != rhs.node_ptr_;
+}  // end operator!=
+
+
+template<class T>
+ConcurrentList<T>::iterator::iterator() : guard_(), node_ptr_(nullptr)
+{
+}  // end constructor
+
+template<class T>
+ConcurrentList<T>::iterator::iterator(typename Domain::Guard guard, ListNode* node_ptr)
+   : guard_(std::move(guard)), node_ptr_(node_ptr)
+{
+}  // end constructor
+
+template<class T>
+ConcurrentList<T>::iterator::operator const_iterator() const
+{
+   return const_iterator(guard_, node_ptr_);
+}  // end operator const_iterator
+
+template<class T>
+T& ConcurrentList<T>::iterator::operator*() const
+{
+   return node_ptr_->item_;
+}  // end operator*
+
+template<class T>
+T* ConcurrentList<T>::iterator::operator->() const
+{
+   return &node_ptr_->item_;
+}  // end operator->
+
+template<class T>
+typename ConcurrentList<T>::iterator& ConcurrentList<T>::iterator::operator++()
+{
+   node_ptr_ = firstLive(nodeOf(node_ptr_->next_.load(std::memory_order_acquire)));
+   return *this;
+}  // end operator++
+
+template<class T>
+typename ConcurrentList<T>::iterator ConcurrentList<T>::iterator::operator++(int)
+{
+   iterator old = *this;
+   ++(*this);
+   return old;
+}  // end operator++
+
+template<class T>
+bool ConcurrentList<T>::iterator::operator==(const iterator& rhs) const
+{
+   return node_ptr_ == rhs.node_ptr_;
+}  // end operator==
+
+template<class T>
+bool ConcurrentList<T>::iterator::operator!=(const iterator& rhs) const
+{
+   return node_ptr_ != rhs.node_ptr_;
+}  // end operator!=
@@ -0,0 +1,230 @@
+/*
+Lock-free list: the positional interface of LinkedList, safe for any number of threads
+to insert, remove, search and iterate at once. Follows Harris's algorithm: a node is
+deleted by first marking its next link, which stops anyone linking after it, and then
+unlinking it; nodes are reclaimed through an EpochDomain once no reader can hold them.
+*/
+
+#ifndef CONCURRENT_LIST_
+#define CONCURRENT_LIST_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include "ChainSort.hpp"
+#include "EpochDomain.hpp"
+#include "PrecondViolatedExcep.hpp"
+
+/**
+    Positions are counted over the nodes that are not marked, at the moment each one is
+    passed. Under concurrent updates an operation therefore acts on the list as it was
+    while that operation walked it; with a single thread it behaves exactly like LinkedList.
+    Positional operations walk from the head, so they are O(n). push_back appends after a
+    tail hint instead, following any appends made since it was set; it only walks from the
+    head when the hint led to a removed node.
+**/
+template<class T>
+class ConcurrentList
+{
+   struct ListNode;
+   typedef EpochDomain<ListNode> Domain;
+
+   // A next link holds a ListNode* with its low bit set once the node owning it is deleted
+   typedef std::atomic<std::uintptr_t> Link;
+
+   struct ListNode
+   {
+      Link next_;
+      ListNode* retired_next_;  // used by Domain once unlinked
+      T item_;
+
+      template<class... Args>
+      explicit ListNode(Args&&... args);
+   }; // end ListNode
+
+public:
+   // Forward iterator over the items, in list order. Nodes it passes stay valid while
+   // the iterator is alive, even if other threads remove them.
+   class const_iterator
+   {
+   public:
+      typedef std::forward_iterator_tag iterator_category;
+      typedef T value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const T* pointer;
+      typedef const T& reference;
+
+      const_iterator();
+      const_iterator(typename Domain::Guard guard, ListNode* node_ptr);
+
+      const T& operator*() const;
+      const T* operator->() const;
+      const_iterator& operator++();
+      const_iterator operator++(int);
+      bool operator==(const const_iterator& rhs) const;
+      bool operator!=(const const_iterator& rhs) const;
+
+   private:
+      typename Domain::Guard guard_; // Pins the nodes for as long as the iterator lives
+      ListNode* node_ptr_;           // Current node, nullptr past the end
+   }; // end const_iterator
+
+   // Forward iterator that can modify the items in place
+   class iterator
+   {
+   public:
+      typedef std::forward_iterator_tag iterator_category;
+      typedef T value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef T* pointer;
+      typedef T& reference;
+
+      iterator();
+      iterator(typename Domain::Guard guard, ListNode* node_ptr);
+      operator const_iterator() const;
+
+      T& operator*() const;
+      T* operator->() const;
+      iterator& operator++();
+      iterator operator++(int);
+      bool operator==(const iterator& rhs) const;
+      bool operator!=(const iterator& rhs) const;
+
+   private:
+      typename Domain::Guard guard_; // Pins the nodes for as long as the iterator lives
+      ListNode* node_ptr_;           // Current node, nullptr past the end
+   }; // end iterator
+
+   ConcurrentList(); // constructor
+   ConcurrentList(const ConcurrentList<T>& a_list); // copy constructor, a snapshot of a_list
+   ConcurrentList<T>& operator=(const ConcurrentList<T>& a_list) = delete;
+   virtual ~ConcurrentList(); // destructor, once no other thread uses the list
+
+   /**@return true if list is empty - item_count_ == 0 */
+   bool isEmpty() const;
+
+    /**@return the number of items in the list - item_count_, exact once updates have finished */
+   int getLength() const;
+
+    /**
+     @pre list positions follow traditional indexing from 0 to item_count_ -1
+     @param position indicating point of insertion
+     @param new_entry to be inserted in list
+     @post new_entry is added at position in list (the item previously at that position is now at position+1)
+     @return true if valid position (0 <= position <= item_count_) */
+   bool insert(int position, const T& new_entry);
+   bool insert(int position, T&& new_entry);
+
+    /**
+     @pre list positions follow traditional indexing from 0 to item_count_ -1
+     @param position indicating point of insertion
+     @param args arguments for T's constructor
+     @post an item built in place from args is added at position in list
+     @return true if valid position (0 <= position <= item_count_) */
+   template<class... Args>
+   bool emplace(int position, Args&&... args);
+
+    /**
+     @param new_entry to be inserted in list
+     @post new_entry is added at the end of the list */
+   void push_back(const T& new_entry);
+   void push_back(T&& new_entry);
+
+    /**
+     @param new_entry to be inserted in list
+     @post new_entry is added at the beginning of the list */
+   void push_front(const T& new_entry);
+   void push_front(T&& new_entry);
+
+    /**
+     @pre list positions follow traditional indexing from 0 to item_count_ -1
+     @param position indicating point of deletion
+     @post item at position is deleted, if any. List order is retained
+     @return true if there is an item at position to be deleted, false otherwise */
+   bool remove(int position);
+
+    /**
+     @param an_entry the item to look for
+     @return true if an item equal to an_entry is in the list */
+   bool contains(const T& an_entry) const;
+
+   /**@post the list is empty and item_count_ == 0, except for items other threads add meanwhile */
+   void clear();
+
+    /**
+     @pre no other thread is using the list
+     @param comp strict weak ordering on items
+     @post the items are in stable sorted order, relinking the existing nodes in O(n log n) */
+   template<class Compare = std::less<T>>
+   void sort(Compare comp = Compare());
+
+    /**
+     @pre list positions follow traditional indexing from 0 to item_count_ -1
+     @param position indicating the position of the data to be retrieved
+     @return a copy of the item found at position. If position is not a valid position < item_count_
+            throws  PrecondViolatedExcep */
+   T getEntry(int position) const;
+
+    /**
+     @param position indicating the position of the data to be retrieved
+     @return a pointer to the item at position, or nullptr if position is not a valid
+            position < item_count_. Never throws. The pointer is only safe to use while
+            no other thread may remove the item; otherwise use getEntry or an iterator. */
+   T* tryGetEntry(int position);
+   const T* tryGetEntry(int position) const;
+
+    /**@return iterator to the first item */
+   iterator begin();
+   const_iterator begin() const;
+
+    /**@return iterator past the last item */
+   iterator end();
+   const_iterator end() const;
+
+protected:
+    static constexpr int END = -1;  // position past every item, for findNode
+
+    mutable Link head_;             // Link to the first node, never marked
+    std::atomic<int> item_count_;   // Count of list items, updated after each link or mark
+    mutable Domain domain_;         // Reclaims removed nodes
+
+    // A node recently linked in last, or nullptr. It is still the last node while its next
+    // link is null and unmarked. It is withdrawn before its node is retired, and a thread
+    // that published it withdraws it again if the node was removed meanwhile.
+    mutable std::atomic<ListNode*> tail_hint_;
+
+    // @return  the node held by a link, without its mark
+    static ListNode* nodeOf(std::uintptr_t link);
+
+    // @return  true if the node owning a link has been deleted
+    static bool isMarked(std::uintptr_t link);
+
+    // @return  the first node from node_ptr on that is not marked, or nullptr
+    static ListNode* firstLive(ListNode* node_ptr);
+
+    // Walks to a position, unlinking and retiring any marked node on the way.
+    // @pre the caller holds a guard on domain_
+    // @param position the position to find, or END for the end of the list
+    // @param pred_link set to the link that leads to position
+    // @param cur_ptr set to the node at position, nullptr at the end of the list
+    // @return  false if the list has fewer than position items
+    bool findNode(int position, Link*& pred_link, ListNode*& cur_ptr) const;
+
+    // @post new_node_ptr is linked in at position, or deleted if position is not valid
+    // @return  true if new_node_ptr was linked in
+    bool linkNode(int position, ListNode* new_node_ptr);
+
+    // @pre the caller's guard on domain_ was taken before node_ptr was linked in
+    // @param seen_ptr the tail hint as the caller read it before linking node_ptr in last
+    // @post the tail hint is node_ptr, unless the hint changed since or node_ptr was removed
+    void publishTail(ListNode* seen_ptr, ListNode* node_ptr);
+
+    // @pre node_ptr is unlinked, and the caller holds a guard on domain_
+    // @post node_ptr is no longer the tail hint, and is left to domain_ to delete
+    void retireNode(ListNode* node_ptr) const;
+}; // end ConcurrentList
+
+#include "ConcurrentList.cpp"
+#endif
@@ -0,0 +1,159 @@
+/*
+Throughput benchmark for ConcurrentList against a LinkedList guarded by a std::mutex,
+for 1, 2, 4 and 8 threads sharing the work of three workloads:
+  append   2M push_backs onto an empty list
+  queue    2M operations alternating push_back and remove(0) on a list of 1000 items
+  scan     64 full iterations of a 100K-item list, summing the items
+Build and run with `make concurrentlist_bench && ./concurrentlist_bench`.
+*/
+
+#include "ConcurrentList.hpp"
+#include "LinkedList.hpp"
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+static const int APPENDS = 2000000;
+static const int QUEUE_OPERATIONS = 2000000;
+static const int QUEUE_LENGTH = 1000;
+static const int SCAN_LENGTH = 100000;
+static const int SCANS = 64;
+
+// Stops the compiler from dropping scans whose sums are unused
+static volatile long sink;
+
+/*
+    @param threads how many workers to run
+    @param total units of work, split evenly between the workers
+    @param work called as work(count) on each worker thread
+    @return seconds until every worker has finished
+*/
+template<class Work>
+static double timeWorkers(int threads, int total, Work work)
+{
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::thread> workers;
+	for (int t = 0; t < threads; t++)
+	{
+		workers.emplace_back(work, total / threads);
+	}  // end for
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}  // end for
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/*
+    @param name the workload
+    @param threads how many workers shared it
+    @param total units of work done by each list
+    @post prints both lists' throughput in millions of units per second
+*/
+static void report(const char* name, int threads, int total, double lock_free_seconds, double locked_seconds)
+{
+	std::printf("  %-7s %d threads: ConcurrentList %8.2f M/s, mutex + LinkedList %8.2f M/s\n",
+		name, threads, total / lock_free_seconds / 1e6, total / locked_seconds / 1e6);
+}
+
+int main()
+{
+	std::printf("%d hardware threads\n", static_cast<int>(std::thread::hardware_concurrency()));
+	for (int threads : { 1, 2, 4, 8 })
+	{
+		{
+			ConcurrentList<long> lock_free;
+			double lock_free_seconds = timeWorkers(threads, APPENDS, [&](int count) {
+				for (int i = 0; i < count; i++)
+				{
+					lock_free.push_back(i);
+				}  // end for
+			});
+
+			LinkedList<long> locked;
+			std::mutex lock;
+			double locked_seconds = timeWorkers(threads, APPENDS, [&](int count) {
+				for (int i = 0; i < count; i++)
+				{
+					std::lock_guard<std::mutex> guard(lock);
+					locked.push_back(i);
+				}  // end for
+			});
+			report("append", threads, APPENDS, lock_free_seconds, locked_seconds);
+		}
+
+		{
+			ConcurrentList<long> lock_free;
+			LinkedList<long> locked;
+			for (int i = 0; i < QUEUE_LENGTH; i++)
+			{
+				lock_free.push_back(i);
+				locked.push_back(i);
+			}  // end for
+
+			double lock_free_seconds = timeWorkers(threads, QUEUE_OPERATIONS, [&](int count) {
+				for (int i = 0; i < count; i += 2)
+				{
+					lock_free.push_back(i);
+					lock_free.remove(0);
+				}  // end for
+			});
+
+			std::mutex lock;
+			double locked_seconds = timeWorkers(threads, QUEUE_OPERATIONS, [&](int count) {
+				for (int i = 0; i < count; i += 2)
+				{
+					{
+						std::lock_guard<std::mutex> guard(lock);
+						locked.push_back(i);
+					}
+					std::lock_guard<std::mutex> guard(lock);
+					locked.remove(0);
+				}  // end for
+			});
+			report("queue", threads, QUEUE_OPERATIONS, lock_free_seconds, locked_seconds);
+		}
+
+		{
+			ConcurrentList<long> lock_free;
+			LinkedList<long> locked;
+			for (int i = 0; i < SCAN_LENGTH; i++)
+			{
+				lock_free.push_back(i);
+				locked.push_back(i);
+			}  // end for
+
+			const ConcurrentList<long>& lock_free_reader = lock_free;
+			double lock_free_seconds = timeWorkers(threads, SCANS, [&](int count) {
+				for (int s = 0; s < count; s++)
+				{
+					long sum = 0;
+					for (long item : lock_free_reader)
+					{
+						sum += item;
+					}  // end for
+					sink = sum;
+				}  // end for
+			});
+
+			const LinkedList<long>& locked_reader = locked;
+			std::mutex lock;
+			double locked_seconds = timeWorkers(threads, SCANS, [&](int count) {
+				for (int s = 0; s < count; s++)
+				{
+					std::lock_guard<std::mutex> guard(lock);
+					long sum = 0;
+					for (long item : locked_reader)
+					{
+						sum += item;
+					}  // end for
+					sink = sum;
+				}  // end for
+			});
+			report("scan", threads, SCANS * SCAN_LENGTH, lock_free_seconds, locked_seconds);
+		}
+	}  // end for
+	return 0;
+}
@@ -0,0 +1,158 @@
+/*
+Stress test for ConcurrentList.
+Producers add distinct values, even ones with push_back and odd ones with push_front,
+while removers delete at random positions (the last one half the time, so push_back
+keeps losing its tail hint) and a reader iterates, holding more iterators at once than
+EpochDomain has slots. Every pass, and the list left at the end, is checked for values
+that are duplicated, out of order or never added; at the end every value must be either
+still in the list or counted as removed.
+Build and run with `make concurrentlist_stress && ./concurrentlist_stress`.
+*/
+
+#include "ConcurrentList.hpp"
+#include <atomic>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+static const int PRODUCERS = 4;
+static const int ITEMS_PER_PRODUCER = 20000;
+static const int REMOVERS = 2;
+static const int HELD_ITERATORS = 200;
+static const int YIELD_EVERY = 16;
+
+/*
+    @param list the list to walk once
+    @param count set to the number of items passed
+    @return a description of the first problem found, or nullptr if every value was added
+            by a producer, is there once, and each producer's values are in the order it added them
+*/
+static const char* checkPass(const ConcurrentList<long>& list, long& count)
+{
+	// Producer p adds p * ITEMS_PER_PRODUCER + i for rising i, so appended values rise and prepended ones fall
+	std::vector<long> last(PRODUCERS, -1);
+	std::vector<bool> seen(PRODUCERS * ITEMS_PER_PRODUCER, false);
+	count = 0;
+	for (long value : list)
+	{
+		if (value < 0 || value >= PRODUCERS * ITEMS_PER_PRODUCER)
+		{
+			return "a value nobody added";
+		}  // end if
+		if (seen[value])
+		{
+			return "a duplicated value";
+		}  // end if
+		seen[value] = true;
+
+		int producer = static_cast<int>(value / ITEMS_PER_PRODUCER);
+		bool in_order = (producer % 2 == 0) ? value > last[producer] : (last[producer] == -1 || value < last[producer]);
+		if (!in_order)
+		{
+			return "a producer's values out of order";
+		}  // end if
+		last[producer] = value;
+		count++;
+	}  // end for
+	return nullptr;
+}
+
+int main()
+{
+	ConcurrentList<long> list;
+	std::atomic<int> producing(PRODUCERS);
+	std::atomic<long> removed(0);
+	std::atomic<long> passes(0);
+	std::atomic<const char*> failure(nullptr);
+
+	std::vector<std::thread> threads;
+	for (int p = 0; p < PRODUCERS; p++)
+	{
+		threads.emplace_back([&, p]() {
+			for (int i = 0; i < ITEMS_PER_PRODUCER; i++)
+			{
+				long value = static_cast<long>(p) * ITEMS_PER_PRODUCER + i;
+				if (p % 2 == 0)
+				{
+					list.push_back(value);
+				}
+				else
+				{
+					list.push_front(value);
+				}  // end if
+
+				// Give removers and the reader a turn even on a single core
+				if (i % YIELD_EVERY == 0)
+				{
+					std::this_thread::yield();
+				}  // end if
+			}  // end for
+			producing--;
+		});
+	}  // end for
+
+	for (int r = 0; r < REMOVERS; r++)
+	{
+		threads.emplace_back([&, r]() {
+			std::mt19937 random(r);
+			while (producing > 0)
+			{
+				int length = list.getLength();
+				if (length > 0 && list.remove((random() % 2) ? length - 1 : static_cast<int>(random() % length)))
+				{
+					removed++;
+				}  // end if
+			}  // end while
+		});
+	}  // end for
+
+	threads.emplace_back([&]() {
+		const ConcurrentList<long>& reader = list;
+		while (producing > 0)
+		{
+			std::vector<ConcurrentList<long>::const_iterator> held;
+			for (int k = 0; k < HELD_ITERATORS; k++)
+			{
+				held.push_back(reader.begin());
+			}  // end for
+
+			long count;
+			const char* problem = checkPass(reader, count);
+			if (problem)
+			{
+				failure = problem;
+			}  // end if
+			passes++;
+		}  // end while
+	});
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}  // end for
+
+	long left = 0;
+	const char* problem = failure.load();
+	if (!problem)
+	{
+		problem = checkPass(list, left);
+	}  // end if
+	if (!problem && left != list.getLength())
+	{
+		problem = "getLength disagreeing with iteration";
+	}  // end if
+	if (!problem && left + removed != static_cast<long>(PRODUCERS) * ITEMS_PER_PRODUCER)
+	{
+		problem = "a lost value";
+	}  // end if
+
+	if (problem)
+	{
+		std::printf("FAILED: found %s\n", problem);
+		return 1;
+	}  // end if
+	std::printf("passed: %d added, %ld removed, %ld left, %ld reader passes\n",
+		PRODUCERS * ITEMS_PER_PRODUCER, removed.load(), left, passes.load());
+	return 0;
+}
@@ -0,0 +1,255 @@
+/*
+Bag that stores each distinct item once, with a count.
+*/
+
+#include "CountedBag.hpp"
+
+// ********* ExpandedIterator **************//
+
+template<class ItemType, class Hash, class KeyEqual>
+CountedBag<ItemType, Hash, KeyEqual>::ExpandedIterator::ExpandedIterator(const_iterator entry, int repeat)
+	: entry_(entry), repeat_(repeat)
+{
+}  // end constructor
+
+template<class ItemType, class Hash, class KeyEqual>
+const ItemType& CountedBag<ItemType, Hash, KeyEqual>::ExpandedIterator::operator*() const
+{
+	return entry_->first;
+}  // end operator*
+
+template<class ItemType, class Hash, class KeyEqual>
+const ItemType* CountedBag<ItemType, Hash, KeyEqual>::ExpandedIterator::operator->() const
+{
+	return &entry_->first;
+}  // end operator->
+
+template<class ItemType, class Hash, class KeyEqual>
+typename CountedBag<ItemType, Hash, KeyEqual>::ExpandedIterator& CountedBag<ItemType, Hash, KeyEqual>::ExpandedIterator::operator++()
+{
+	// Move on to the next distinct item once every copy of this one has been visited
+	repeat_++;
+	if (repeat_ == entry_->second)
+	{
+		++entry_;
+		repeat_ = 0;
+	}  // end if
+	return *this;
+}  // end operator++
+
+template<class ItemType, class Hash, class KeyEqual>
+typename CountedBag<ItemType, Hash, KeyEqual>::ExpandedIterator CountedBag<ItemType, Hash, KeyEqual>::ExpandedIterator::operator++(int)
+{
+	ExpandedIterator before = *this;
+	++(*this);
+	return before;
+}  // end operator++
+
+template<class ItemType, class Hash, class KeyEqual>
+bool CountedBag<ItemType, Hash, KeyEqual>::ExpandedIterator::operator==(const ExpandedIterator& rhs) const
+{
+	return entry_ == rhs.entry_ && repeat_ == rhs.repeat_;
+}  // end operator==
+
+template<class ItemType, class Hash, class KeyEqual>
+bool CountedBag<ItemType, Hash, KeyEqual>::ExpandedIterator::operator!=(const ExpandedIterator& rhs) const
+{
+	return !(*this == rhs);
+}  // end operator!=
+
+// ********* CountedBag **************//
+
+/** default constructor**/
+template<class ItemType, class Hash, class KeyEqual>
+CountedBag<ItemType, Hash, KeyEqual>::CountedBag(): item_count_(0)
+{
+}  // end default constructor
+
+/**
+ @return item_count_ : the current size of the bag, counting every copy
+ **/
+template<class ItemType, class Hash, class KeyEqual>
+int CountedBag<ItemType, Hash, KeyEqual>::getCurrentSize() const
+{
+	return item_count_;
+}  // end getCurrentSize
+
+/**
+ @return the number of distinct items in the bag
+ **/
+template<class ItemType, class Hash, class KeyEqual>
+int CountedBag<ItemType, Hash, KeyEqual>::getDistinctCount() const
+{
+	return static_cast<int>(counts_.size());
+}  // end getDistinctCount
+
+/**
+ @return true if item_count_ == 0, false otherwise
+ **/
+template<class ItemType, class Hash, class KeyEqual>
+bool CountedBag<ItemType, Hash, KeyEqual>::isEmpty() const
+{
+	return item_count_ == 0;
+}  // end isEmpty
+
+/**
+ @post one more copy of new_entry is counted
+ @return true
+ **/
+template<class ItemType, class Hash, class KeyEqual>
+bool CountedBag<ItemType, Hash, KeyEqual>::add(const ItemType& new_entry)
+{
+	return add(new_entry, 1);
+}  // end add
+
+/**
+ @param copies the number of copies of new_entry to add
+ @post copies more of new_entry are counted
+ @return true if copies > 0 and they were added, false otherwise
+ **/
+template<class ItemType, class Hash, class KeyEqual>
+bool CountedBag<ItemType, Hash, KeyEqual>::add(const ItemType& new_entry, int copies)
+{
+	if (copies <= 0)
+	{
+		return false;
+	}  // end if
+
+	counts_[new_entry] += copies;
+	item_count_ += copies;
+	return true;
+}  // end add
+
+/**
+ @post one copy of an_entry is uncounted; the entry is dropped when none are left
+ @return true if an_entry was successfully removed, false otherwise
+ **/
+template<class ItemType, class Hash, class KeyEqual>
+bool CountedBag<ItemType, Hash, KeyEqual>::remove(const ItemType& an_entry)
+{
+	auto found = counts_.find(an_entry);
+	if (found == counts_.end())
+	{
+		return false;
+	}  // end if
+
+	found->second--;
+	if (found->second == 0)
+	{
+		counts_.erase(found);
+	}  // end if
+	item_count_--;
+	return true;
+}  // end remove
+
+/**
+ @post every copy of an_entry is removed
+ @return the number of copies removed
+ **/
+template<class ItemType, class Hash, class KeyEqual>
+int CountedBag<ItemType, Hash, KeyEqual>::removeAll(const ItemType& an_entry)
+{
+	auto found = counts_.find(an_entry);
+	if (found == counts_.end())
+	{
+		return 0;
+	}  // end if
+
+	int removed = found->second;
+	counts_.erase(found);
+	item_count_ -= removed;
+	return removed;
+}  // end removeAll
+
+/**
+ @post item_count_ == 0
+ **/
+template<class ItemType, class Hash, class KeyEqual>
+void CountedBag<ItemType, Hash, KeyEqual>::clear()
+{
+	counts_.clear();
+	item_count_ = 0;
+}  // end clear
+
+/**
+ @return true if an_entry is in the bag, false otherwise
+ **/
+template<class ItemType, class Hash, class KeyEqual>
+bool CountedBag<ItemType, Hash, KeyEqual>::contains(const ItemType& an_entry) const
+{
+	return counts_.find(an_entry) != counts_.end();
+}  // end contains
+
+/**
+ @return the number of times an_entry is in the bag, in O(1) expected
+ **/
+template<class ItemType, class Hash, class KeyEqual>
+int CountedBag<ItemType, Hash, KeyEqual>::getFrequencyOf(const ItemType& an_entry) const
+{
+	auto found = counts_.find(an_entry);
+	return (found == counts_.end()) ? 0 : found->second;
+}  // end getFrequencyOf
+
+template<class ItemType, class Hash, class KeyEqual>
+void CountedBag<ItemType, Hash, KeyEqual>::operator/=(const CountedBag<ItemType, Hash, KeyEqual>& rhs)
+{
+	if (this == &rhs)
+	{
+		return;
+	}  // end if
+
+	for (const auto& entry : rhs.counts_)
+	{
+		if (counts_.emplace(entry.first, 1).second)
+		{
+			item_count_++;
+		}  // end if
+	}  // end for
+}
+
+template<class ItemType, class Hash, class KeyEqual>
+void CountedBag<ItemType, Hash, KeyEqual>::operator+=(const CountedBag<ItemType, Hash, KeyEqual>& rhs)
+{
+	if (this == &rhs)
+	{
+		// Doubling in place; iterating rhs while inserting into it would be unsafe
+		for (auto& entry : counts_)
+		{
+			entry.second *= 2;
+		}  // end for
+		item_count_ *= 2;
+		return;
+	}  // end if
+
+	for (const auto& entry : rhs.counts_)
+	{
+		counts_[entry.first] += entry.second;
+	}  // end for
+	item_count_ += rhs.item_count_;
+}
+
+/** @return compressed iterators over the (item, count) pairs **/
+template<class ItemType, class Hash, class KeyEqual>
+typename CountedBag<ItemType, Hash, KeyEqual>::const_iterator CountedBag<ItemType, Hash, KeyEqual>::begin() const
+{
+	return counts_.begin();
+}  // end begin
+
+template<class ItemType, class Hash, class KeyEqual>
+typename CountedBag<ItemType, Hash, KeyEqual>::const_iterator CountedBag<ItemType, Hash, KeyEqual>::end() const
+{
+	return counts_.end();
+}  // end end
+
+/** @return expanded iterators visiting every copy **/
+template<class ItemType, class Hash, class KeyEqual>
+typename CountedBag<ItemType, Hash, KeyEqual>::ExpandedIterator CountedBag<ItemType, Hash, KeyEqual>::expandedBegin() const
+{
+	return ExpandedIterator(counts_.begin(), 0);
+}  // end expandedBegin
+
+template<class ItemType, class Hash, class KeyEqual>
+typename CountedBag<ItemType, Hash, KeyEqual>::ExpandedIterator CountedBag<ItemType, Hash, KeyEqual>::expandedEnd() const
+{
+	return ExpandedIterator(counts_.end(), 0);
+}  // end expandedEnd
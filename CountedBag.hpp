@@ -0,0 +1,139 @@
+/*
+Bag that stores each distinct item once, with a count, instead of one copy per occurrence.
+Meant for heavily duplicated contents, where it uses memory per distinct item rather than
+per item and answers getFrequencyOf without scanning.
+*/
+
+#ifndef COUNTED_BAG_
+#define COUNTED_BAG_
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <unordered_map>
+
+/**
+    Same interface as ArrayBag, backed by a hash map from item to count.
+    @param Hash hash function for ItemType
+    @param KeyEqual equality used to group items (in place of operator==)
+**/
+template <class ItemType, class Hash = std::hash<ItemType>, class KeyEqual = std::equal_to<ItemType>>
+class CountedBag
+{
+   typedef std::unordered_map<ItemType, int, Hash, KeyEqual> CountMap;
+
+   public:
+   /** Compressed iteration: one (item, count) pair per distinct item **/
+   typedef typename CountMap::const_iterator const_iterator;
+
+   /** Expanded iteration: each item repeated count times **/
+   class ExpandedIterator
+   {
+      public:
+      typedef std::forward_iterator_tag iterator_category;
+      typedef ItemType value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const ItemType *pointer;
+      typedef const ItemType &reference;
+
+      ExpandedIterator(const_iterator entry, int repeat);
+
+      reference operator*() const;
+      pointer operator->() const;
+      ExpandedIterator &operator++();
+      ExpandedIterator operator++(int);
+      bool operator==(const ExpandedIterator &rhs) const;
+      bool operator!=(const ExpandedIterator &rhs) const;
+
+      private:
+      const_iterator entry_;  // current distinct item
+      int repeat_;            // how many of its copies have been visited
+   }; // end ExpandedIterator
+
+   /** default constructor**/
+   CountedBag();
+
+   /**
+       @return item_count_ : the current size of the bag, counting every copy
+   **/
+   int getCurrentSize() const;
+
+   /**
+       @return the number of distinct items in the bag
+   **/
+   int getDistinctCount() const;
+
+   /**
+       @return true if item_count_ == 0, false otherwise
+   **/
+   bool isEmpty() const;
+
+   /**
+       @post one more copy of new_entry is counted
+       @return true
+   **/
+   bool add(const ItemType &new_entry);
+
+   /**
+       @param copies the number of copies of new_entry to add
+       @post copies more of new_entry are counted
+       @return true if copies > 0 and they were added, false otherwise
+   **/
+   bool add(const ItemType &new_entry, int copies);
+
+   /**
+       @post one copy of an_entry is uncounted; the entry is dropped when none are left
+       @return true if an_entry was successfully removed, false otherwise
+   **/
+   bool remove(const ItemType &an_entry);
+
+   /**
+       @post every copy of an_entry is removed
+       @return the number of copies removed
+   **/
+   int removeAll(const ItemType &an_entry);
+
+   /**
+       @post item_count_ == 0
+   **/
+   void clear();
+
+   /**
+       @return true if an_entry is in the bag, false otherwise
+   **/
+   bool contains(const ItemType &an_entry) const;
+
+   /**
+       @return the number of times an_entry is in the bag, in O(1) expected
+   **/
+   int getFrequencyOf(const ItemType &an_entry) const;
+
+   /**
+       @param:   another CountedBag object
+       @post:    Adds one copy of each distinct item of a_bag not already in this bag.
+                 Example: [1, 2, 3] /= [1, 4, 4] will produce [1, 2, 3, 4]
+   */
+   void operator/= (const CountedBag &a_bag);
+
+   /**
+       @param:   another CountedBag object
+       @post:    Adds every copy from a_bag, in O(distinct items of a_bag).
+                 Example: [1, 2, 3] += [1, 4] will produce [1, 1, 2, 3, 4]
+   */
+   void operator+= (const CountedBag &a_bag);
+
+   /** @return compressed iterators over the (item, count) pairs **/
+   const_iterator begin() const;
+   const_iterator end() const;
+
+   /** @return expanded iterators visiting every copy **/
+   ExpandedIterator expandedBegin() const;
+   ExpandedIterator expandedEnd() const;
+
+   private:
+   CountMap counts_;   // distinct item -> number of copies (always > 0)
+   int item_count_;    // sum of counts_
+}; // end CountedBag
+
+#include "CountedBag.cpp"
+#endif
@@ -0,0 +1,29 @@
+/** @file DoubleNode.cpp
+ Node for Doubly Linked Chain*/
+
+
+#include "DoubleNode.hpp"
+
+//in-place constructor
+template<class T>
+template<class... Args>
+DoubleNode<T>::DoubleNode(std::in_place_t, Args&&... args)
+   : Node<T>(std::in_place, std::forward<Args>(args)...), prev_(nullptr)
+{
+} // end constructor
+
+
+/** @param prev_node_ptr points to the previous node in the chain
+ @post sets prev_ to prev_node_ptr */
+template<class T>
+void DoubleNode<T>::setPrev(DoubleNode<T>* prev_node_ptr)
+{
+   prev_ = prev_node_ptr;
+} // end setPrev
+
+ /**@return prev_*/
+template<class T>
+DoubleNode<T>* DoubleNode<T>::getPrev() const
+{
+   return prev_;
+} // end getPrev
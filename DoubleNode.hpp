@@ -0,0 +1,31 @@
+/** @file DoubleNode.hpp
+    Node for Doubly Linked Chain: a Node that also points back to its predecessor*/
+
+#ifndef DOUBLE_NODE_
+#define DOUBLE_NODE_
+
+#include <utility>
+#include "Node.hpp"
+
+template<class T>
+class DoubleNode : public Node<T>
+{
+public:
+   /** @param args arguments for T's constructor
+       @post item is constructed in place from args, and prev_ is nullptr */
+   template<class... Args>
+   explicit DoubleNode(std::in_place_t, Args&&... args);
+
+    /** @param prev_node_ptr points to the previous node in the chain
+     @post sets prev_ to prev_node_ptr */
+   void setPrev(DoubleNode<T>* prev_node_ptr);
+
+    /**@return prev_*/
+   DoubleNode<T>* getPrev() const;
+
+private:
+    DoubleNode<T>* prev_; // Pointer to previous node, nullptr at the head
+}; // end DoubleNode
+
+#include "DoubleNode.cpp"
+#endif
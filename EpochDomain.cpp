@@ -0,0 +1,204 @@
+/*
+Epoch-based reclamation for lock-free linked structures.
+*/
+
+#include "EpochDomain.hpp"
+#include <functional>
+#include <thread>
+#include <utility>
+
+// ********* Guard **************//
+
+/** @post this thread is announced in domain **/
+template<class NodeType>
+EpochDomain<NodeType>::Guard::Guard(EpochDomain<NodeType>& domain): domain_(&domain), slot_(domain.enter())
+{
+}  // end constructor
+
+/** empty guard, protecting nothing **/
+template<class NodeType>
+EpochDomain<NodeType>::Guard::Guard(): domain_(nullptr), slot_(-1)
+{
+}  // end default constructor
+
+template<class NodeType>
+EpochDomain<NodeType>::Guard::Guard(const Guard& other): domain_(other.domain_), slot_(other.slot_)
+{
+	// other holds the slot, so it cannot be freed before this joins it
+	if (domain_)
+	{
+		domain_->join(slot_);
+	}  // end if
+}  // end copy constructor
+
+template<class NodeType>
+EpochDomain<NodeType>::Guard::Guard(Guard&& other): domain_(other.domain_), slot_(other.slot_)
+{
+	other.domain_ = nullptr;
+}  // end move constructor
+
+template<class NodeType>
+typename EpochDomain<NodeType>::Guard& EpochDomain<NodeType>::Guard::operator=(Guard other)
+{
+	std::swap(domain_, other.domain_);
+	std::swap(slot_, other.slot_);
+	return *this;
+}  // end operator=
+
+/** @post the slot is released **/
+template<class NodeType>
+EpochDomain<NodeType>::Guard::~Guard()
+{
+	if (domain_)
+	{
+		domain_->leave(slot_);
+	}  // end if
+}  // end destructor
+
+// ********* EpochDomain **************//
+
+template<class NodeType>
+EpochDomain<NodeType>::EpochDomain(): global_epoch_(0)
+{
+	for (int i = 0; i < SLOTS; i++)
+	{
+		slots_[i].epoch_.store(INACTIVE, std::memory_order_relaxed);
+		slots_[i].holders_.store(0, std::memory_order_relaxed);
+	}  // end for
+	for (int i = 0; i < LISTS; i++)
+	{
+		retired_[i].store(nullptr, std::memory_order_relaxed);
+	}  // end for
+}  // end default constructor
+
+/** destructor: deletes every retired node. No guard may be alive. **/
+template<class NodeType>
+EpochDomain<NodeType>::~EpochDomain()
+{
+	for (int i = 0; i < LISTS; i++)
+	{
+		deleteChain(retired_[i].load(std::memory_order_acquire));
+	}  // end for
+}  // end destructor
+
+/**
+ @pre the caller holds a Guard, and node_ptr is no longer reachable from the structure
+ @post node_ptr will be deleted once no guard that could have seen it is alive
+ **/
+template<class NodeType>
+void EpochDomain<NodeType>::retire(NodeType* node_ptr)
+{
+	// The caller's guard announced an epoch <= this one, so the epoch cannot reach
+	// epoch + 3, where this list is deleted, before the caller is done
+	std::uint64_t epoch = global_epoch_.load(std::memory_order_acquire);
+	std::atomic<NodeType*>& list = retired_[epoch % LISTS];
+	node_ptr->retired_next_ = list.load(std::memory_order_relaxed);
+	while (!list.compare_exchange_weak(node_ptr->retired_next_, node_ptr, std::memory_order_release, std::memory_order_relaxed))
+	{
+	}  // end while
+
+	tryAdvance();
+}  // end retire
+
+// ********* PRIVATE METHODS **************//
+
+/** @return a claimed slot announcing the current epoch, or a held one announcing an earlier epoch **/
+template<class NodeType>
+int EpochDomain<NodeType>::enter()
+{
+	// Start from a per-thread slot so threads rarely compete for the same one
+	int start = static_cast<int>(std::hash<std::thread::id>()(std::this_thread::get_id()) % SLOTS);
+	for (;;)
+	{
+		for (int k = 0; k < SLOTS; k++)
+		{
+			int slot = (start + k) % SLOTS;
+			std::uint64_t expected = INACTIVE;
+			std::uint64_t epoch = global_epoch_.load(std::memory_order_acquire);
+			if (slots_[slot].epoch_.compare_exchange_strong(expected, epoch, std::memory_order_relaxed))
+			{
+				slots_[slot].holders_.store(1, std::memory_order_release);
+				// The announcement must be visible before this thread reads any link
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				return slot;
+			}  // end if
+		}  // end for
+
+		// Every slot is taken. Sharing a held one pins an epoch no later than the current
+		// one, which protects this guard at least as well as announcing its own
+		for (int k = 0; k < SLOTS; k++)
+		{
+			int slot = (start + k) % SLOTS;
+			if (join(slot))
+			{
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				return slot;
+			}  // end if
+		}  // end for
+		std::this_thread::yield();  // Every holder was just leaving; their slots are free now
+	}  // end for
+}  // end enter
+
+/**
+ @param slot a slot to share
+ @return true if slot was still held, and now has one more holder
+ **/
+template<class NodeType>
+bool EpochDomain<NodeType>::join(int slot)
+{
+	// A slot whose holders reached 0 is being freed and must not be revived
+	int holders = slots_[slot].holders_.load(std::memory_order_acquire);
+	while (holders > 0)
+	{
+		if (slots_[slot].holders_.compare_exchange_weak(holders, holders + 1, std::memory_order_acq_rel))
+		{
+			return true;
+		}  // end if
+	}  // end while
+	return false;
+}  // end join
+
+/** @post slot has one holder fewer, and is free again if that was the last **/
+template<class NodeType>
+void EpochDomain<NodeType>::leave(int slot)
+{
+	if (slots_[slot].holders_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+	{
+		slots_[slot].epoch_.store(INACTIVE, std::memory_order_release);
+	}  // end if
+}  // end leave
+
+/** @post the epoch is advanced, and the nodes it made safe deleted, if every guard has caught up **/
+template<class NodeType>
+void EpochDomain<NodeType>::tryAdvance()
+{
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	std::uint64_t epoch = global_epoch_.load(std::memory_order_acquire);
+	for (int i = 0; i < SLOTS; i++)
+	{
+		std::uint64_t announced = slots_[i].epoch_.load(std::memory_order_acquire);
+		if (announced != INACTIVE && announced != epoch)
+		{
+			return;
+		}  // end if
+	}  // end for
+
+	if (global_epoch_.compare_exchange_strong(epoch, epoch + 1, std::memory_order_acq_rel))
+	{
+		// Now at epoch + 1: whatever was retired in epoch - 2 is out of everyone's reach,
+		// even through a re-publishing guard that announced epoch - 2 and has since left
+		deleteChain(retired_[(epoch + 2) % LISTS].exchange(nullptr, std::memory_order_acq_rel));
+	}  // end if
+}  // end tryAdvance
+
+/** @post every node in the retire list starting at node_ptr is deleted **/
+template<class NodeType>
+void EpochDomain<NodeType>::deleteChain(NodeType* node_ptr)
+{
+	while (node_ptr)
+	{
+		NodeType* next_ptr = node_ptr->retired_next_;
+		delete node_ptr;
+		node_ptr = next_ptr;
+	}  // end while
+}  // end deleteChain
@@ -0,0 +1,102 @@
+/*
+Epoch-based reclamation for lock-free linked structures.
+A node unlinked by one thread may still be in use by another thread that read a pointer
+to it just before. Such nodes are retired instead of deleted, and are only deleted once
+every thread that could have seen them has finished its operation.
+*/
+
+#ifndef EPOCH_DOMAIN_
+#define EPOCH_DOMAIN_
+
+#include <atomic>
+#include <cstdint>
+
+/**
+    Threads announce the global epoch in a slot while inside an operation (see Guard).
+    The epoch only advances once every announced slot has caught up to it, so nodes
+    retired in epoch e are unreachable by anyone by the time it reaches e + 2. They are
+    deleted at e + 3, which also covers a node that a thread re-publishes after it was
+    retired, as long as that thread's guard predates the retirement and the node is
+    withdrawn again before the guard ends (see ConcurrentList's tail hint).
+    NodeType must have a `NodeType* retired_next_` member for the retire lists.
+**/
+template <class NodeType>
+class EpochDomain
+{
+   public:
+   /**
+       Pins the epoch for as long as it lives; hold one around every access to nodes.
+       Guards may nest and may be copied. A copy shares its original's slot, and once
+       every slot is taken a new guard shares a held one, so guards never wait.
+   **/
+   class Guard
+   {
+      public:
+      /** @post this thread is announced in domain **/
+      explicit Guard(EpochDomain<NodeType> &domain);
+
+      /** empty guard, protecting nothing **/
+      Guard();
+
+      Guard(const Guard &other);
+      Guard(Guard &&other);
+      Guard &operator=(Guard other);
+
+      /** @post the slot is released **/
+      ~Guard();
+
+      private:
+      EpochDomain<NodeType> *domain_;  // nullptr for an empty guard
+      int slot_;                       // held with every guard sharing it
+   }; // end Guard
+
+   EpochDomain();
+   EpochDomain(const EpochDomain<NodeType> &other) = delete;
+   EpochDomain<NodeType> &operator=(const EpochDomain<NodeType> &other) = delete;
+
+   /** destructor: deletes every retired node. No guard may be alive. **/
+   ~EpochDomain();
+
+   /**
+       @pre the caller holds a Guard, and node_ptr is no longer reachable from the structure
+       @post node_ptr will be deleted once no guard that could have seen it is alive
+   **/
+   void retire(NodeType *node_ptr);
+
+   private:
+   static constexpr int SLOTS = 128;  // announcements at once; further guards share them
+   static constexpr std::uint64_t INACTIVE = ~std::uint64_t(0);
+
+   /** A slot on its own cache line, so announcing does not contend with neighbours **/
+   struct alignas(64) Slot
+   {
+      std::atomic<std::uint64_t> epoch_;  // announced epoch, INACTIVE when free
+      std::atomic<int> holders_;          // guards sharing the slot; it is freed at 0
+   };
+
+   std::atomic<std::uint64_t> global_epoch_;
+   Slot slots_[SLOTS];
+   static constexpr int LISTS = 4;  // retire lists: the epoch of retirement plus three of grace
+   std::atomic<NodeType *> retired_[LISTS];  // retired in epoch e go on retired_[e % LISTS]
+
+   /** @return a claimed slot announcing the current epoch, or a held one announcing an earlier epoch **/
+   int enter();
+
+   /**
+       @param slot a slot to share
+       @return true if slot was still held, and now has one more holder
+   **/
+   bool join(int slot);
+
+   /** @post slot has one holder fewer, and is free again if that was the last **/
+   void leave(int slot);
+
+   /** @post the epoch is advanced, and the nodes it made safe deleted, if every guard has caught up **/
+   void tryAdvance();
+
+   /** @post every node in the retire list starting at node_ptr is deleted **/
+   static void deleteChain(NodeType *node_ptr);
+}; // end EpochDomain
+
+#include "EpochDomain.cpp"
+#endif
@@ -13,38 +13,51 @@
 
 #include "LinkedList.hpp"  // Header file
 #include <cassert>
+#include <cstdlib>
+#include <utility>
 
 // constructor
-template<class T>
-LinkedList<T>::LinkedList() : head_ptr_(nullptr), item_count_(0)
+template<class T, class Allocator, bool DOUBLY_LINKED>
+LinkedList<T, Allocator, DOUBLY_LINKED>::LinkedList() : head_ptr_(nullptr), tail_ptr_(nullptr), item_count_(0),
+     cursor_ptr_(nullptr), cursor_pos_(0)
 {
 }  // end default constructor
 
 
+// constructor drawing nodes from node_allocator
+template<class T, class Allocator, bool DOUBLY_LINKED>
+LinkedList<T, Allocator, DOUBLY_LINKED>::LinkedList(const Allocator& node_allocator)
+   : node_alloc_(node_allocator), head_ptr_(nullptr), tail_ptr_(nullptr), item_count_(0),
+     cursor_ptr_(nullptr), cursor_pos_(0)
+{
+}  // end allocator constructor
+
+
 // copy constructor
-template<class T>
-LinkedList<T>::LinkedList(const LinkedList<T>& a_list) : item_count_(a_list.item_count_)
+template<class T, class Allocator, bool DOUBLY_LINKED>
+LinkedList<T, Allocator, DOUBLY_LINKED>::LinkedList(const LinkedList<T, Allocator, DOUBLY_LINKED>& a_list)
+   : node_alloc_(NodeTraits::select_on_container_copy_construction(a_list.node_alloc_)),
+     item_count_(a_list.item_count_), cursor_ptr_(nullptr), cursor_pos_(0)
 {
    Node<T>* orig_chain_pointer = a_list.head_ptr_;  // Points to nodes in original chain
 
    if (orig_chain_pointer == nullptr)
+   {
       head_ptr_ = nullptr;  // Original list is empty
+      tail_ptr_ = nullptr;
+   }
    else
    {
       // Copy first node
-      head_ptr_ = new Node<T>();
-      head_ptr_->setItem(orig_chain_pointer->getItem());
+      head_ptr_ = createNode(orig_chain_pointer->item());
 
       // Copy remaining nodes
       Node<T>* new_chain_ptr = head_ptr_;      // Points to last node in new chain
       orig_chain_pointer = orig_chain_pointer->getNext();     // Advance original-chain pointer
       while (orig_chain_pointer != nullptr)
       {
-         // Get next item from original chain
-         T next_item = orig_chain_pointer->getItem();
-
-         // Create a new node containing the next item
-         Node<T>* new_node_ptr = new Node<T>(next_item);
+         // Create a new node containing the next item from original chain
+         Node<T>* new_node_ptr = createNode(orig_chain_pointer->item());
 
          // Link new node to end of new chain
          new_chain_ptr->setNext(new_node_ptr);
@@ -57,13 +70,15 @@ LinkedList<T>::LinkedList(const LinkedList<T>& a_list) : item_count_(a_list.item
       }  // end while
 
       new_chain_ptr->setNext(nullptr);              // Flag end of chain
+      tail_ptr_ = new_chain_ptr;
+      relinkPrev();
    }  // end if
 }  // end copy constructor
 
 
 // destructor
-template<class T>
-LinkedList<T>::~LinkedList()
+template<class T, class Allocator, bool DOUBLY_LINKED>
+LinkedList<T, Allocator, DOUBLY_LINKED>::~LinkedList()
 {
    clear();
 }  // end destructor
@@ -71,16 +86,16 @@ LinkedList<T>::~LinkedList()
 
 
 /**@return true if list is empty - item_count_ == 0 */
-template<class T>
-bool LinkedList<T>::isEmpty() const
+template<class T, class Allocator, bool DOUBLY_LINKED>
+bool LinkedList<T, Allocator, DOUBLY_LINKED>::isEmpty() const
 {
    return item_count_ == 0;
 }  // end isEmpty
 
 
 /**@return the number of items in the list - item_count_ */
-template<class T>
-int LinkedList<T>::getLength() const
+template<class T, class Allocator, bool DOUBLY_LINKED>
+int LinkedList<T, Allocator, DOUBLY_LINKED>::getLength() const
 {
    return item_count_;
 }  // end getLength
@@ -93,37 +108,49 @@ int LinkedList<T>::getLength() const
  @param new_entry to be inserted in list
  @post new_entry is added at position in list (the node previously at that position is now at position+1)
  @return true if valid position (0 <= position <= item_count_) */
-template<class T>
-bool LinkedList<T>::insert(int positions, const T& new_entry)
+template<class T, class Allocator, bool DOUBLY_LINKED>
+bool LinkedList<T, Allocator, DOUBLY_LINKED>::insert(int positions, const T& new_entry)
 {
-   bool able_to_insert = (positions >= 0) && (positions <= item_count_ );
-   if (able_to_insert)
-   {
-      // Create a new node containing the new entry
-      Node<T>* new_node_ptr = new Node<T>(new_entry);
+   return emplace(positions, new_entry);
+}  // end insert
 
-      // Attach new node to chain
-      if (positions == 0)
-      {
-         // Insert new node at beginning of chain
-         new_node_ptr->setNext(head_ptr_);
-         head_ptr_ = new_node_ptr;
-      }
-      else
-      {
-         // Find node that will be before new node
-         Node<T>* prev_ptr = getNodeAt(positions - 1);
+template<class T, class Allocator, bool DOUBLY_LINKED>
+bool LinkedList<T, Allocator, DOUBLY_LINKED>::insert(int positions, T&& new_entry)
+{
+   return emplace(positions, std::move(new_entry));
+}  // end insert
 
-         // Insert new node after node to which prev_ptr points
-         new_node_ptr->setNext(prev_ptr->getNext());
-         prev_ptr->setNext(new_node_ptr);
-      }  // end if
 
-      item_count_++;  // Increase count of entries
+
+/**
+ @pre list positions follow traditional indexing from 0 to item_count_ -1
+ @param position indicating point of insertion
+ @param args arguments for T's constructor
+ @post an item built in place from args is added at position in list
+ @return true if valid position (0 <= position <= item_count_) */
+template<class T, class Allocator, bool DOUBLY_LINKED>
+template<class... Args>
+bool LinkedList<T, Allocator, DOUBLY_LINKED>::emplace(int positions, Args&&... args)
+{
+   bool able_to_insert = (positions >= 0) && (positions <= item_count_ );
+   if (able_to_insert)
+   {
+      // Find node that will be before new node; appending needs no walk
+      Node<T>* prev_ptr = nullptr;
+      if (positions == item_count_)
+         prev_ptr = tail_ptr_;
+      else if (positions > 0)
+         prev_ptr = getNodeAt(positions - 1);
+
+      linkAfter(prev_ptr, std::forward<Args>(args)...);
+
+      // The cursor's node moved one place back if the new node went in before it
+      if (cursor_ptr_ != nullptr && positions <= cursor_pos_)
+         cursor_pos_++;
    }  // end if
 
    return able_to_insert;
-}  // end insert
+}  // end emplace
 
 
 
@@ -132,8 +159,8 @@ bool LinkedList<T>::insert(int positions, const T& new_entry)
  @param position indicating point of deletion
  @post node at position is deleted, if any. List order is retains
  @return true if there is a node at position to be deleted, false otherwise */
-template<class T>
-bool LinkedList<T>::remove(int position)
+template<class T, class Allocator, bool DOUBLY_LINKED>
+bool LinkedList<T, Allocator, DOUBLY_LINKED>::remove(int position)
 {
    bool able_to_remove = (position >= 0) && (position < item_count_);
    if (able_to_remove)
@@ -144,6 +171,10 @@ bool LinkedList<T>::remove(int position)
          // Remove the first node in the chain
          cur_ptr = head_ptr_; // Save pointer to node
          head_ptr_ = head_ptr_->getNext();
+         if (head_ptr_ == nullptr)
+            tail_ptr_ = nullptr;
+         else
+            setPrev(head_ptr_, nullptr);
       }
       else
       {
@@ -156,11 +187,21 @@ bool LinkedList<T>::remove(int position)
          // Disconnect indicated node from chain by connecting the
          // prior node with the one after
          prev_ptr->setNext(cur_ptr->getNext());
+         if (cur_ptr == tail_ptr_)
+            tail_ptr_ = prev_ptr;
+         else
+            setPrev(cur_ptr->getNext(), prev_ptr);
       }  // end if
 
+      // Keep the cursor off the removed node
+      if (cursor_ptr_ != nullptr && position < cursor_pos_)
+         cursor_pos_--;
+      else if (cur_ptr == cursor_ptr_)
+         resetCursor();
+
       // Return node to system
       cur_ptr->setNext(nullptr);
-      delete cur_ptr;
+      destroyNode(cur_ptr);
       cur_ptr = nullptr;
 
       item_count_--;  // Decrease count of entries
@@ -171,30 +212,271 @@ bool LinkedList<T>::remove(int position)
 
 
 
+/**
+ @pre where is a handle to an item of this list
+ @param where the item to delete
+ @post the item is deleted and where, like any other handle to it, is no longer valid
+ @return a handle to the item that followed it, or an empty handle if it was the last */
+template<class T, class Allocator, bool DOUBLY_LINKED>
+typename LinkedList<T, Allocator, DOUBLY_LINKED>::Handle LinkedList<T, Allocator, DOUBLY_LINKED>::erase(Handle where)
+{
+   Node<T>* cur_ptr = where.node_ptr_;
+   Node<T>* next_ptr = cur_ptr->getNext();
+
+   Node<T>* prev_ptr = nullptr;
+   if constexpr (DOUBLY_LINKED)
+   {
+      prev_ptr = static_cast<DoubleNode<T>*>(cur_ptr)->getPrev();
+   }
+   else if (cur_ptr != head_ptr_)
+   {
+      // Without back links the predecessor has to be found from the head
+      prev_ptr = head_ptr_;
+      while (prev_ptr->getNext() != cur_ptr)
+         prev_ptr = prev_ptr->getNext();
+   }  // end if
+
+   // Disconnect the node by connecting its neighbours to each other
+   if (prev_ptr == nullptr)
+      head_ptr_ = next_ptr;
+   else
+      prev_ptr->setNext(next_ptr);
+   if (next_ptr == nullptr)
+      tail_ptr_ = prev_ptr;
+   else
+      setPrev(next_ptr, prev_ptr);
+
+   // The handle carries no position, so the cursor's position can no longer be trusted
+   resetCursor();
+
+   cur_ptr->setNext(nullptr);
+   destroyNode(cur_ptr);
+   item_count_--;  // Decrease count of entries
+
+   return Handle(next_ptr);
+}  // end erase
+
+
+
 /**@post the list is empty and item_count_ == 0*/
-template<class T>
-void LinkedList<T>::clear()
+template<class T, class Allocator, bool DOUBLY_LINKED>
+void LinkedList<T, Allocator, DOUBLY_LINKED>::clear()
 {
    while (!isEmpty())
       remove(0);
+   tail_ptr_ = nullptr;
+   resetCursor();
 }  // end clear
 
 
 
+/**
+ @param new_entry to be inserted in list
+ @post new_entry is added at the end of the list in O(1)
+ @return a handle to the new item */
+template<class T, class Allocator, bool DOUBLY_LINKED>
+typename LinkedList<T, Allocator, DOUBLY_LINKED>::Handle LinkedList<T, Allocator, DOUBLY_LINKED>::push_back(const T& new_entry)
+{
+   return Handle(linkAfter(tail_ptr_, new_entry));
+}  // end push_back
+
+template<class T, class Allocator, bool DOUBLY_LINKED>
+typename LinkedList<T, Allocator, DOUBLY_LINKED>::Handle LinkedList<T, Allocator, DOUBLY_LINKED>::push_back(T&& new_entry)
+{
+   return Handle(linkAfter(tail_ptr_, std::move(new_entry)));
+}  // end push_back
+
+
+
+/**
+ @param new_entry to be inserted in list
+ @post new_entry is added at the beginning of the list in O(1)
+ @return a handle to the new item */
+template<class T, class Allocator, bool DOUBLY_LINKED>
+typename LinkedList<T, Allocator, DOUBLY_LINKED>::Handle LinkedList<T, Allocator, DOUBLY_LINKED>::push_front(const T& new_entry)
+{
+   return emplaceAfter(Handle(), new_entry);
+}  // end push_front
+
+template<class T, class Allocator, bool DOUBLY_LINKED>
+typename LinkedList<T, Allocator, DOUBLY_LINKED>::Handle LinkedList<T, Allocator, DOUBLY_LINKED>::push_front(T&& new_entry)
+{
+   return emplaceAfter(Handle(), std::move(new_entry));
+}  // end push_front
+
+
+
+/**
+ @pre where is a handle to an item of this list, or an empty handle
+ @param where the item to insert after; an empty handle inserts at the front
+ @param new_entry to be inserted in list
+ @post new_entry is added right after where's item in O(1)
+ @return a handle to the new item */
+template<class T, class Allocator, bool DOUBLY_LINKED>
+typename LinkedList<T, Allocator, DOUBLY_LINKED>::Handle LinkedList<T, Allocator, DOUBLY_LINKED>::insertAfter(Handle where, const T& new_entry)
+{
+   return emplaceAfter(where, new_entry);
+}  // end insertAfter
+
+template<class T, class Allocator, bool DOUBLY_LINKED>
+typename LinkedList<T, Allocator, DOUBLY_LINKED>::Handle LinkedList<T, Allocator, DOUBLY_LINKED>::insertAfter(Handle where, T&& new_entry)
+{
+   return emplaceAfter(where, std::move(new_entry));
+}  // end insertAfter
+
+
+
+/**
+ @pre where is a handle to an item of this list, or an empty handle
+ @param where the item to insert after; an empty handle inserts at the front
+ @param args arguments for T's constructor
+ @post an item built in place from args is added right after where's item in O(1)
+ @return a handle to the new item */
+template<class T, class Allocator, bool DOUBLY_LINKED>
+template<class... Args>
+typename LinkedList<T, Allocator, DOUBLY_LINKED>::Handle LinkedList<T, Allocator, DOUBLY_LINKED>::emplaceAfter(Handle where, Args&&... args)
+{
+   Node<T>* new_node_ptr = linkAfter(where.node_ptr_, std::forward<Args>(args)...);
+
+   // Keep the cursor only when the new node is known to be before it (front) or after it
+   if (where.node_ptr_ == nullptr)
+   {
+      if (cursor_ptr_ != nullptr)
+         cursor_pos_++;
+   }
+   else if (where.node_ptr_ != cursor_ptr_)
+   {
+      resetCursor();
+   }  // end if
+
+   return Handle(new_node_ptr);
+}  // end emplaceAfter
+
+
+
+/**
+ @param position where the first of other's items should land (0 <= position <= item_count_)
+ @param other the list whose items are moved into this one
+ @post other's items are at positions [position, position + other's length) in their
+ original order, and other is empty
+ @return true if valid position, false otherwise (other is left unchanged) */
+template<class T, class Allocator, bool DOUBLY_LINKED>
+bool LinkedList<T, Allocator, DOUBLY_LINKED>::splice(int position, LinkedList<T, Allocator, DOUBLY_LINKED>& other)
+{
+   bool able_to_splice = (position >= 0) && (position <= item_count_);
+   if (able_to_splice && this != &other && !other.isEmpty())
+   {
+      adoptNodes(other);
+      Node<T>* first_ptr = other.head_ptr_;
+      Node<T>* last_ptr = other.tail_ptr_;
+      int count = other.item_count_;
+      other.release();
+
+      if (position == 0)
+      {
+         last_ptr->setNext(head_ptr_);
+         if (head_ptr_ != nullptr)
+            setPrev(head_ptr_, last_ptr);
+         head_ptr_ = first_ptr;
+         if (tail_ptr_ == nullptr)
+            tail_ptr_ = last_ptr;
+      }
+      else if (position == item_count_)
+      {
+         tail_ptr_->setNext(first_ptr);
+         setPrev(first_ptr, tail_ptr_);
+         tail_ptr_ = last_ptr;
+      }
+      else
+      {
+         Node<T>* prev_ptr = getNodeAt(position - 1);
+         last_ptr->setNext(prev_ptr->getNext());
+         setPrev(last_ptr->getNext(), last_ptr);
+         prev_ptr->setNext(first_ptr);
+         setPrev(first_ptr, prev_ptr);
+      }  // end if
+
+      if (cursor_ptr_ != nullptr && position <= cursor_pos_)
+         cursor_pos_ += count;
+      item_count_ += count;
+   }  // end if
+
+   return able_to_splice;
+}  // end splice
+
+
+
+/**
+ @pre this list and other are both sorted by comp
+ @param other the list whose items are merged into this one
+ @param comp strict weak ordering on items
+ @post this list holds both lists' items in sorted order, with this list's items first
+ among equal ones, and other is empty */
+template<class T, class Allocator, bool DOUBLY_LINKED>
+template<class Compare>
+void LinkedList<T, Allocator, DOUBLY_LINKED>::merge(LinkedList<T, Allocator, DOUBLY_LINKED>& other, Compare comp)
+{
+   if (this == &other || other.isEmpty())
+      return;
+
+   adoptNodes(other);
+   Node<T>* other_head_ptr = other.head_ptr_;
+   int count = other.item_count_;
+   other.release();
+
+   head_ptr_ = mergeChains(head_ptr_, other_head_ptr,
+                           [](Node<T>* node_ptr) { return node_ptr->getNext(); },
+                           [](Node<T>* node_ptr, Node<T>* next_ptr) { node_ptr->setNext(next_ptr); },
+                           [&comp](Node<T>* lhs, Node<T>* rhs) { return comp(lhs->item(), rhs->item()); },
+                           tail_ptr_);
+   relinkPrev();
+   item_count_ += count;
+   resetCursor();
+}  // end merge
+
+
+
+/**
+ @param comp strict weak ordering on items
+ @post the items are in stable sorted order, relinking the existing nodes */
+template<class T, class Allocator, bool DOUBLY_LINKED>
+template<class Compare>
+void LinkedList<T, Allocator, DOUBLY_LINKED>::sort(Compare comp)
+{
+   head_ptr_ = sortChain(head_ptr_,
+                         [](Node<T>* node_ptr) { return node_ptr->getNext(); },
+                         [](Node<T>* node_ptr, Node<T>* next_ptr) { node_ptr->setNext(next_ptr); },
+                         [&comp](Node<T>* lhs, Node<T>* rhs) { return comp(lhs->item(), rhs->item()); },
+                         tail_ptr_);
+   relinkPrev();
+   resetCursor();
+}  // end sort
+
+
+
 /**
  @pre list positions follow traditional indexing from 0 to item_count_ -1
  @param position indicating the position of the data to be retrieved
  @return data item found at position. If position is not a valid position < item_count_
  throws  PrecondViolatedExcep */
-template<class T>
-T LinkedList<T>::getEntry(int position) const
+template<class T, class Allocator, bool DOUBLY_LINKED>
+T LinkedList<T, Allocator, DOUBLY_LINKED>::getEntry(int position)
+{
+    Node<T>* node_ptr = getNodeAt(position);
+    if (node_ptr == nullptr)
+        return std::as_const(*this).getEntry(position);  // throws for the bad position
+    return node_ptr->item();
+}  // end getEntry
+
+template<class T, class Allocator, bool DOUBLY_LINKED>
+T LinkedList<T, Allocator, DOUBLY_LINKED>::getEntry(int position) const
 {
     // Enforce precondition
     bool ableToGet = (position >= 0) && (position < item_count_);
     if (ableToGet)
     {
         Node<T>* nodePtr = getNodeAt(position);
-        return nodePtr->getItem();
+        return nodePtr->item();
     }
     else
     {
@@ -206,6 +488,38 @@ T LinkedList<T>::getEntry(int position) const
 
 
 
+/**
+ @param position indicating the position of the data to be retrieved
+ @return a pointer to the item at position, or nullptr if position is not a valid
+ position < item_count_. Never throws. */
+template<class T, class Allocator, bool DOUBLY_LINKED>
+T* LinkedList<T, Allocator, DOUBLY_LINKED>::tryGetEntry(int position)
+{
+   Node<T>* node_ptr = getNodeAt(position);
+   return (node_ptr == nullptr) ? nullptr : &node_ptr->item();
+}  // end tryGetEntry
+
+template<class T, class Allocator, bool DOUBLY_LINKED>
+const T* LinkedList<T, Allocator, DOUBLY_LINKED>::tryGetEntry(int position) const
+{
+   Node<T>* node_ptr = getNodeAt(position);
+   return (node_ptr == nullptr) ? nullptr : &node_ptr->item();
+}  // end tryGetEntry
+
+
+
+/**
+ @param position indicating the item to refer to
+ @return a handle to the item at position, or an empty handle if position is not a
+ valid position < item_count_ */
+template<class T, class Allocator, bool DOUBLY_LINKED>
+typename LinkedList<T, Allocator, DOUBLY_LINKED>::Handle LinkedList<T, Allocator, DOUBLY_LINKED>::handleAt(int position) const
+{
+   return Handle(getNodeAt(position));
+}  // end handleAt
+
+
+
 
 
 /************* PROTECTED METHODS ************/
@@ -216,31 +530,197 @@ T LinkedList<T>::getEntry(int position) const
 // @param position the index of the desired node
 //       0 <= position < item_count_
 // @return  A pointer to the node at the given position or nullptr if position is >= item_count_
-template<class T>
-Node<T>* LinkedList<T>::getNodeAt(int position) const
+template<class T, class Allocator, bool DOUBLY_LINKED>
+Node<T>* LinkedList<T, Allocator, DOUBLY_LINKED>::getNodeAt(int position) const
 {
-    // Count from the beginning of the chain
+    if (position < 0 || position >= item_count_)
+        return nullptr;
+
+    // Count from the closest known node at or before position
     Node<T>* cur_ptr = head_ptr_;
-    for (int skip = 0; skip < position; skip++)
+    int cur_pos = 0;
+    if constexpr (DOUBLY_LINKED)
+    {
+        // Back links allow walking from the tail or the cursor in either direction
+        if (item_count_ - 1 - position < position)
+        {
+            cur_ptr = tail_ptr_;
+            cur_pos = item_count_ - 1;
+        }  // end if
+        if (cursor_ptr_ != nullptr && std::abs(cursor_pos_ - position) < std::abs(cur_pos - position))
+        {
+            cur_ptr = cursor_ptr_;
+            cur_pos = cursor_pos_;
+        }  // end if
+
+        for (; cur_pos > position; cur_pos--)
+            cur_ptr = static_cast<DoubleNode<T>*>(cur_ptr)->getPrev();
+    }
+    else if (position == item_count_ - 1)
+    {
+        cur_ptr = tail_ptr_;
+        cur_pos = position;
+    }
+    else if (cursor_ptr_ != nullptr && cursor_pos_ <= position)
+    {
+        cur_ptr = cursor_ptr_;
+        cur_pos = cursor_pos_;
+    }  // end if
+
+    for (; cur_pos < position; cur_pos++)
         cur_ptr = cur_ptr->getNext();
 
     return cur_ptr;
 }  // end getNodeAt
 
+template<class T, class Allocator, bool DOUBLY_LINKED>
+Node<T>* LinkedList<T, Allocator, DOUBLY_LINKED>::getNodeAt(int position)
+{
+    Node<T>* node_ptr = std::as_const(*this).getNodeAt(position);
+    if (node_ptr != nullptr)
+    {
+        cursor_ptr_ = node_ptr;
+        cursor_pos_ = position;
+    }  // end if
+    return node_ptr;
+}  // end getNodeAt
+
+
+// Allocates and constructs a node from node_alloc_.
+// @param args arguments for the item's constructor
+// @return  A pointer to the new node, whose next_ is nullptr
+template<class T, class Allocator, bool DOUBLY_LINKED>
+template<class... Args>
+Node<T>* LinkedList<T, Allocator, DOUBLY_LINKED>::createNode(Args&&... args)
+{
+   NodeType* node_ptr = NodeTraits::allocate(node_alloc_, 1);
+   try
+   {
+      NodeTraits::construct(node_alloc_, node_ptr, std::in_place, std::forward<Args>(args)...);
+   }
+   catch (...)
+   {
+      NodeTraits::deallocate(node_alloc_, node_ptr, 1);
+      throw;
+   }  // end try
+   return node_ptr;
+}  // end createNode
+
+
+// Destroys a node and returns its memory to node_alloc_.
+// @param node_ptr a node made by createNode, already unlinked from the chain
+template<class T, class Allocator, bool DOUBLY_LINKED>
+void LinkedList<T, Allocator, DOUBLY_LINKED>::destroyNode(Node<T>* node_ptr)
+{
+   NodeType* typed_ptr = static_cast<NodeType*>(node_ptr);
+   NodeTraits::destroy(node_alloc_, typed_ptr);
+   NodeTraits::deallocate(node_alloc_, typed_ptr, 1);
+}  // end destroyNode
+
+
+// @post the cursor is unset
+template<class T, class Allocator, bool DOUBLY_LINKED>
+void LinkedList<T, Allocator, DOUBLY_LINKED>::resetCursor()
+{
+   cursor_ptr_ = nullptr;
+   cursor_pos_ = 0;
+}  // end resetCursor
+
+
+// @post node_ptr points back to prev_ptr when DOUBLY_LINKED (no-op otherwise)
+template<class T, class Allocator, bool DOUBLY_LINKED>
+void LinkedList<T, Allocator, DOUBLY_LINKED>::setPrev(Node<T>* node_ptr, Node<T>* prev_ptr)
+{
+   if constexpr (DOUBLY_LINKED)
+      static_cast<DoubleNode<T>*>(node_ptr)->setPrev(static_cast<DoubleNode<T>*>(prev_ptr));
+}  // end setPrev
+
+
+// @post every node points back to its predecessor when DOUBLY_LINKED (no-op otherwise)
+template<class T, class Allocator, bool DOUBLY_LINKED>
+void LinkedList<T, Allocator, DOUBLY_LINKED>::relinkPrev()
+{
+   if constexpr (DOUBLY_LINKED)
+   {
+      Node<T>* prev_ptr = nullptr;
+      for (Node<T>* cur_ptr = head_ptr_; cur_ptr != nullptr; cur_ptr = cur_ptr->getNext())
+      {
+         setPrev(cur_ptr, prev_ptr);
+         prev_ptr = cur_ptr;
+      }  // end for
+   }  // end if
+}  // end relinkPrev
+
+
+// Creates a node and links it into the chain. Leaves the cursor to the caller.
+// @param prev_ptr the node to link after, or nullptr to link at the front
+// @param args arguments for the item's constructor
+// @return  A pointer to the new node
+template<class T, class Allocator, bool DOUBLY_LINKED>
+template<class... Args>
+Node<T>* LinkedList<T, Allocator, DOUBLY_LINKED>::linkAfter(Node<T>* prev_ptr, Args&&... args)
+{
+   Node<T>* new_node_ptr = createNode(std::forward<Args>(args)...);
+   Node<T>* next_ptr = (prev_ptr == nullptr) ? head_ptr_ : prev_ptr->getNext();
+
+   new_node_ptr->setNext(next_ptr);
+   setPrev(new_node_ptr, prev_ptr);
+   if (prev_ptr == nullptr)
+      head_ptr_ = new_node_ptr;
+   else
+      prev_ptr->setNext(new_node_ptr);
+   if (next_ptr == nullptr)
+      tail_ptr_ = new_node_ptr;
+   else
+      setPrev(next_ptr, new_node_ptr);
+
+   item_count_++;  // Increase count of entries
+   return new_node_ptr;
+}  // end linkAfter
+
+
+// @post other's nodes belong to node_alloc_ (moving their items into new nodes if
+//       the allocators differ), ready to be relinked into this list
+template<class T, class Allocator, bool DOUBLY_LINKED>
+void LinkedList<T, Allocator, DOUBLY_LINKED>::adoptNodes(LinkedList<T, Allocator, DOUBLY_LINKED>& other)
+{
+   if (node_alloc_ == other.node_alloc_)
+      return;
+
+   // Nodes must go back to the allocator they came from, so rebuild the chain from ours
+   LinkedList<T, Allocator, DOUBLY_LINKED> moved{Allocator(node_alloc_)};
+   for (T& item : other)
+      moved.push_back(std::move(item));
+   other.clear();
+
+   // other hands the new chain straight to this list, so it never frees these nodes itself
+   other.head_ptr_ = moved.head_ptr_;
+   other.tail_ptr_ = moved.tail_ptr_;
+   other.item_count_ = moved.item_count_;
+   moved.release();
+}  // end adoptNodes
+
+
+// @post the list is empty without touching the nodes it held
+template<class T, class Allocator, bool DOUBLY_LINKED>
+void LinkedList<T, Allocator, DOUBLY_LINKED>::release()
+{
+   head_ptr_ = nullptr;
+   tail_ptr_ = nullptr;
+   item_count_ = 0;
+   resetCursor();
+}  // end release
+
 //position follows classic indexing from 0 to item_count_-1
 //if position > item_count it returns nullptr
-template <class T>
-Node<T> *LinkedList<T>::getPointerTo(size_t position) const
+template<class T, class Allocator, bool DOUBLY_LINKED>
+Node<T> *LinkedList<T, Allocator, DOUBLY_LINKED>::getPointerTo(size_t position) const
 {
 
   Node<T> *find = nullptr;
-  if (position < item_count_)
+  if (position < static_cast<size_t>(item_count_))
   {
-    find = head_ptr_;
-    for (size_t i = 0; i < position; ++i)
-    {
-      find = find->getNext();
-    }
+    find = getNodeAt(static_cast<int>(position));
   }
 
   return find;
@@ -250,12 +730,211 @@ Node<T> *LinkedList<T>::getPointerTo(size_t position) const
 
 
 //returns the head pointer
-template <class T>
-Node<T> *LinkedList<T>::getHeadNode() const
+template<class T, class Allocator, bool DOUBLY_LINKED>
+Node<T> *LinkedList<T, Allocator, DOUBLY_LINKED>::getHeadNode() const
 {
 
   return head_ptr_;
 } //end getHeadNode
 
 
+/**@return iterator to the first item */
+template<class T, class Allocator, bool DOUBLY_LINKED>
+typename LinkedList<T, Allocator, DOUBLY_LINKED>::iterator LinkedList<T, Allocator, DOUBLY_LINKED>::begin()
+{
+   return iterator(head_ptr_);
+}  // end begin
+
+template<class T, class Allocator, bool DOUBLY_LINKED>
+typename LinkedList<T, Allocator, DOUBLY_LINKED>::const_iterator LinkedList<T, Allocator, DOUBLY_LINKED>::begin() const
+{
+   return const_iterator(head_ptr_);
+}  // end begin
+
+
+/**@return iterator past the last item */
+template<class T, class Allocator, bool DOUBLY_LINKED>
+typename LinkedList<T, Allocator, DOUBLY_LINKED>::iterator LinkedList<T, Allocator, DOUBLY_LINKED>::end()
+{
+   return iterator(nullptr);
+}  // end end
+
+template<class T, class Allocator, bool DOUBLY_LINKED>
+typename LinkedList<T, Allocator, DOUBLY_LINKED>::const_iterator LinkedList<T, Allocator, DOUBLY_LINKED>::end() const
+{
+   return const_iterator(nullptr);
+}  // end end
+
+
+
+/************* HANDLE ************/
+
+
+template<class T, class Allocator, bool DOUBLY_LINKED>
+LinkedList<T, Allocator, DOUBLY_LINKED>::Handle::Handle() : node_ptr_(nullptr)
+{
+}  // end constructor
+
+
+template<class T, class Allocator, bool DOUBLY_LINKED>
+LinkedList<T, Allocator, DOUBLY_LINKED>::Handle::Handle(Node<T>* node_ptr) : node_ptr_(node_ptr)
+{
+}  // end constructor
+
+
+template<class T, class Allocator, bool DOUBLY_LINKED>
+T& LinkedList<T, Allocator, DOUBLY_LINKED>::Handle::operator*() const
+{
+   return node_ptr_->item();
+}  // end operator*
+
+
+template<class T, class Allocator, bool DOUBLY_LINKED>
+T* LinkedList<T, Allocator, DOUBLY_LINKED>::Handle::operator->() const
+{
+   return &node_ptr_->item();
+}  // end operator->
+
+
+template<class T, class Allocator, bool DOUBLY_LINKED>
+LinkedList<T, Allocator, DOUBLY_LINKED>::Handle::operator bool() const
+{
+   return node_ptr_ != nullptr;
+}  // end operator bool
+
+
+template<class T, class Allocator, bool DOUBLY_LINKED>
+bool LinkedList<T, Allocator, DOUBLY_LINKED>::Handle::operator==(const Handle& rhs) const
+{
+   return node_ptr_ == rhs.node_ptr_;
+}  // end operator==
+
+
+template<class T, class Allocator, bool DOUBLY_LINKED>
+bool LinkedList<T, Allocator, DOUBLY_LINKED>::Handle::operator!=(const Handle& rhs) const
+{
+   return node_ptr_ != rhs.node_ptr_;
+}  // end operator!=
+
+
+
+/************* ITERATOR ************/
+
+
+template<class T, class Allocator, bool DOUBLY_LINKED>
+LinkedList<T, Allocator, DOUBLY_LINKED>::const_iterator::const_iterator(Node<T>* node_ptr) : node_ptr_(node_ptr)
+{
+}  // end constructor
+
+
+template<class T, class Allocator, bool DOUBLY_LINKED>
+const T& LinkedList<T, Allocator, DOUBLY_LINKED>::const_iterator::operator*() const
+{
+   return node_ptr_->item();
+}  // end operator*
+
+
+template<class T, class Allocator, bool DOUBLY_LINKED>
+const T* LinkedList<T, Allocator, DOUBLY_LINKED>::const_iterator::operator->() const
+{
+   return &node_ptr_->item();
+}  // end operator->
+
+
+template<class T, class Allocator, bool DOUBLY_LINKED>
+typename LinkedList<T, Allocator, DOUBLY_LINKED>::const_iterator& LinkedList<T, Allocator, DOUBLY_LINKED>::const_iterator::operator++()
+{
+   node_ptr_ = node_ptr_->getNext();
+   return *this;
+}  // end operator++
+
+
+template<class T, class Allocator, bool DOUBLY_LINKED>
+typename LinkedList<T, Allocator, DOUBLY_LINKED>::const_iterator LinkedList<T, Allocator, DOUBLY_LINKED>::const_iterator::operator++(int)
+{
+   const_iterator before = *this;
+   node_ptr_ = node_ptr_->getNext();
+   return before;
+}  // end operator++
+
+
+template<class T, class Allocator, bool DOUBLY_LINKED>
+bool LinkedList<T, Allocator, DOUBLY_LINKED>::const_iterator::operator==(const const_iterator& rhs) const
+{
+   return node_ptr_ == rhs.node_ptr_;
+}  // end operator==
+
+
+template<class T, class Allocator, bool DOUBLY_LINKED>
+bool LinkedList<T, Allocator, DOUBLY_LINKED>::const_iterator::operator!=(const const_iterator& rhs) const
+{
+   return node_ptr_ != rhs.node_ptr_;
+}  // end operator!=
+
+
+template<class T, class Allocator, bool DOUBLY_LINKED>
+LinkedList<T, Allocator, DOUBLY_LINKED>::iterator::iterator(Node<T>* node_ptr) : node_ptr_(node_ptr)
+{
+}  // end constructor
+
+
+template<class T, class Allocator, bool DOUBLY_LINKED>
+LinkedList<T, Allocator, DOUBLY_LINKED>::iterator::operator const_iterator() const
+{
+   return const_iterator(node_ptr_);
+}  // end operator const_iterator
+
+
+template<class T, class Allocator, bool DOUBLY_LINKED>
+typename LinkedList<T, Allocator, DOUBLY_LINKED>::Handle LinkedList<T, Allocator, DOUBLY_LINKED>::iterator::handle() const
+{
+   return Handle(node_ptr_);
+}  // end handle
+
+
+template<class T, class Allocator, bool DOUBLY_LINKED>
+T& LinkedList<T, Allocator, DOUBLY_LINKED>::iterator::operator*() const
+{
+   return node_ptr_->item();
+}  // end operator*
+
+
+template<class T, class Allocator, bool DOUBLY_LINKED>
+T* LinkedList<T, Allocator, DOUBLY_LINKED>::iterator::operator->() const
+{
+   return &node_ptr_->item();
+}  // end operator->
+
+
+template<class T, class Allocator, bool DOUBLY_LINKED>
+typename LinkedList<T, Allocator, DOUBLY_LINKED>::iterator& LinkedList<T, Allocator, DOUBLY_LINKED>::iterator::operator++()
+{
+   node_ptr_ = node_ptr_->getNext();
+   return *this;
+}  // end operator++
+
+
+template<class T, class Allocator, bool DOUBLY_LINKED>
+typename LinkedList<T, Allocator, DOUBLY_LINKED>::iterator LinkedList<T, Allocator, DOUBLY_LINKED>::iterator::operator++(int)
+{
+   iterator before = *this;
+   node_ptr_ = node_ptr_->getNext();
+   return before;
+}  // end operator++
+
+
+template<class T, class Allocator, bool DOUBLY_LINKED>
+bool LinkedList<T, Allocator, DOUBLY_LINKED>::iterator::operator==(const iterator& rhs) const
+{
+   return node_ptr_ == rhs.node_ptr_;
+}  // end operator==
+
+
+template<class T, class Allocator, bool DOUBLY_LINKED>
+bool LinkedList<T, Allocator, DOUBLY_LINKED>::iterator::operator!=(const iterator& rhs) const
+{
+   return node_ptr_ != rhs.node_ptr_;
+}  // end operator!=
+
+
 //  End of implementation file.
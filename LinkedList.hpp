@@ -13,16 +13,98 @@
 #ifndef LINKED_LIST_
 #define LINKED_LIST_
 
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include "ChainSort.hpp"
+#include "DoubleNode.hpp"
 #include "Node.hpp"
 #include "PrecondViolatedExcep.hpp"
 
-template<class T>
+// Allocator is rebound to Node<T> and used for every node in the chain;
+// PoolAllocator<T> (NodePool.hpp) recycles nodes instead of going to the global heap.
+// With DOUBLY_LINKED the nodes are DoubleNodes, which also point back, so erase(handle)
+// is O(1) at the cost of one more pointer per node.
+template<class T, class Allocator = std::allocator<T>, bool DOUBLY_LINKED = false>
 class LinkedList
 {
 
 public:
+   // Stable reference to one item, valid until that item is removed from the list.
+   // Unlike a position, it is not affected by inserts and removals elsewhere.
+   class Handle
+   {
+   public:
+      Handle(); // refers to no item
+
+      T& operator*() const;
+      T* operator->() const;
+      explicit operator bool() const; // true if the handle refers to an item
+      bool operator==(const Handle& rhs) const;
+      bool operator!=(const Handle& rhs) const;
+
+   private:
+      friend class LinkedList;
+      explicit Handle(Node<T>* node_ptr);
+
+      Node<T>* node_ptr_; // The item's node, nullptr for no item
+   }; // end Handle
+
+   // Forward iterator over the items, in list order
+   class const_iterator
+   {
+   public:
+      typedef std::forward_iterator_tag iterator_category;
+      typedef T value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const T* pointer;
+      typedef const T& reference;
+
+      explicit const_iterator(Node<T>* node_ptr = nullptr);
+
+      const T& operator*() const;
+      const T* operator->() const;
+      const_iterator& operator++();
+      const_iterator operator++(int);
+      bool operator==(const const_iterator& rhs) const;
+      bool operator!=(const const_iterator& rhs) const;
+
+   private:
+      Node<T>* node_ptr_; // Current node, nullptr past the end
+   }; // end const_iterator
+
+   // Forward iterator that can modify the items in place
+   class iterator
+   {
+   public:
+      typedef std::forward_iterator_tag iterator_category;
+      typedef T value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef T* pointer;
+      typedef T& reference;
+
+      explicit iterator(Node<T>* node_ptr = nullptr);
+      operator const_iterator() const;
+
+      /**@return a handle to the current item */
+      Handle handle() const;
+
+      T& operator*() const;
+      T* operator->() const;
+      iterator& operator++();
+      iterator operator++(int);
+      bool operator==(const iterator& rhs) const;
+      bool operator!=(const iterator& rhs) const;
+
+   private:
+      Node<T>* node_ptr_; // Current node, nullptr past the end
+   }; // end iterator
+
    LinkedList(); // constructor
-   LinkedList(const LinkedList<T>& a_list); // copy constructor
+   explicit LinkedList(const Allocator& node_allocator); // constructor drawing nodes from node_allocator
+   LinkedList(const LinkedList<T, Allocator, DOUBLY_LINKED>& a_list); // copy constructor
    virtual ~LinkedList(); // destructor
 
    /**@return true if list is empty - item_count_ == 0 */
@@ -39,6 +121,48 @@ public:
      @post new_entry is added at position in list (the node previously at that position is now at position+1)
      @return true if valid position (0 <= position <= item_count_) */
    bool insert(int position, const T& new_entry);
+   bool insert(int position, T&& new_entry);
+
+    /**
+     @pre list positions follow traditional indexing from 0 to item_count_ -1
+     @param position indicating point of insertion
+     @param args arguments for T's constructor
+     @post an item built in place from args is added at position in list
+     @return true if valid position (0 <= position <= item_count_) */
+   template<class... Args>
+   bool emplace(int position, Args&&... args);
+
+    /**
+     @param new_entry to be inserted in list
+     @post new_entry is added at the end of the list in O(1)
+     @return a handle to the new item */
+   Handle push_back(const T& new_entry);
+   Handle push_back(T&& new_entry);
+
+    /**
+     @param new_entry to be inserted in list
+     @post new_entry is added at the beginning of the list in O(1)
+     @return a handle to the new item */
+   Handle push_front(const T& new_entry);
+   Handle push_front(T&& new_entry);
+
+    /**
+     @pre where is a handle to an item of this list, or an empty handle
+     @param where the item to insert after; an empty handle inserts at the front
+     @param new_entry to be inserted in list
+     @post new_entry is added right after where's item in O(1)
+     @return a handle to the new item */
+   Handle insertAfter(Handle where, const T& new_entry);
+   Handle insertAfter(Handle where, T&& new_entry);
+
+    /**
+     @pre where is a handle to an item of this list, or an empty handle
+     @param where the item to insert after; an empty handle inserts at the front
+     @param args arguments for T's constructor
+     @post an item built in place from args is added right after where's item in O(1)
+     @return a handle to the new item */
+   template<class... Args>
+   Handle emplaceAfter(Handle where, Args&&... args);
 
 
     /**
@@ -48,33 +172,107 @@ public:
      @return true if there is a node at position to be deleted, false otherwise */
    bool remove(int position);
 
+    /**
+     @pre where is a handle to an item of this list
+     @param where the item to delete
+     @post the item is deleted and where, like any other handle to it, is no longer valid.
+           O(1) when DOUBLY_LINKED; otherwise the predecessor is found by walking from the head
+     @return a handle to the item that followed it, or an empty handle if it was the last */
+   Handle erase(Handle where);
+
 
 
    /**@post the list is empty and item_count_ == 0*/
    void clear();
 
 
+    /**
+     @param position where the first of other's items should land (0 <= position <= item_count_)
+     @param other the list whose items are moved into this one
+     @post other's items are at positions [position, position + other's length) in their
+           original order, and other is empty. Relinks other's nodes without copying when
+           both lists share an allocator (always true for std::allocator): O(1) at either end,
+           O(position) in the middle. Otherwise the items are moved into new nodes.
+     @return true if valid position, false otherwise (other is left unchanged) */
+   bool splice(int position, LinkedList<T, Allocator, DOUBLY_LINKED>& other);
+
+
+    /**
+     @pre this list and other are both sorted by comp
+     @param other the list whose items are merged into this one
+     @param comp strict weak ordering on items
+     @post this list holds both lists' items in sorted order, with this list's items first
+           among equal ones, and other is empty. Linear; relinks nodes like splice.
+     */
+   template<class Compare = std::less<T>>
+   void merge(LinkedList<T, Allocator, DOUBLY_LINKED>& other, Compare comp = Compare());
+
+
+    /**
+     @param comp strict weak ordering on items
+     @post the items are in stable sorted order. Bottom-up merge sort: O(n log n) time,
+           relinks the existing nodes and allocates nothing. */
+   template<class Compare = std::less<T>>
+   void sort(Compare comp = Compare());
+
+
     /**
      @pre list positions follow traditional indexing from 0 to item_count_ -1
      @param position indicating the position of the data to be retrieved
      @return data item found at position. If position is not a valid position < item_count_
-            throws  PrecondViolatedExcep */
+            throws  PrecondViolatedExcep
+     The non-const overload moves the cursor, so index loops are amortized O(1);
+     the const one leaves it alone and is safe to call from several threads at once. */
+   T getEntry(int position);
    T getEntry(int position) const;
 
+    /**
+     @param position indicating the position of the data to be retrieved
+     @return a pointer to the item at position, or nullptr if position is not a valid
+            position < item_count_. Never throws. */
+   T* tryGetEntry(int position);
+   const T* tryGetEntry(int position) const;
+
+    /**
+     @param position indicating the item to refer to
+     @return a handle to the item at position, or an empty handle if position is not a
+            valid position < item_count_ */
+   Handle handleAt(int position) const;
+
         //if position > item_count_ returns nullptr
     Node<T> *getPointerTo(size_t position) const;
 
     Node<T> *getHeadNode() const;
 
+    /**@return iterator to the first item */
+   iterator begin();
+   const_iterator begin() const;
+
+    /**@return iterator past the last item */
+   iterator end();
+   const_iterator end() const;
+
 
 
 
 
 protected:
+    typedef typename std::conditional<DOUBLY_LINKED, DoubleNode<T>, Node<T>>::type NodeType;
+    typedef typename std::allocator_traits<Allocator>::template rebind_alloc<NodeType> NodeAllocator;
+    typedef std::allocator_traits<NodeAllocator> NodeTraits;
+
+    NodeAllocator node_alloc_;  // Source of every node in the chain
     Node<T>* head_ptr_; // Pointer to first node in the chain;
     // (contains the first entry in the list)
+    Node<T>* tail_ptr_; // Pointer to last node in the chain, nullptr when empty
     int item_count_;           // Current count of list items
 
+    // Last node found by the non-const getNodeAt, so sequential or nearby positional
+    // access resumes from there instead of from head_ptr_. cursor_ptr_ is nullptr when unset.
+    // Const lookups only read it, so concurrent const access never writes shared state.
+    Node<T>* cursor_ptr_;
+    int cursor_pos_;
+
 
 
     // Locates a specified node in this linked list.
@@ -82,8 +280,37 @@ protected:
     // @param position the index of the desired node
     //       0 <= position < item_count_
     // @return  A pointer to the node at the given position or nullptr if position is >= item_count_
+    // @post the non-const overload leaves the cursor at the node found; the const one leaves it unchanged
+    Node<T>* getNodeAt(int position);
     Node<T>* getNodeAt(int position) const;
 
+    // @return  A new node whose item is built from args, allocated from node_alloc_
+    template<class... Args>
+    Node<T>* createNode(Args&&... args);
+
+    // @post node_ptr is destroyed and its memory returned to node_alloc_
+    void destroyNode(Node<T>* node_ptr);
+
+    // @post the cursor is unset
+    void resetCursor();
+
+    // @post node_ptr points back to prev_ptr when DOUBLY_LINKED (no-op otherwise)
+    static void setPrev(Node<T>* node_ptr, Node<T>* prev_ptr);
+
+    // @post every node points back to its predecessor when DOUBLY_LINKED (no-op otherwise)
+    void relinkPrev();
+
+    // @return  a new node built from args, linked in after prev_ptr (at the front if nullptr)
+    template<class... Args>
+    Node<T>* linkAfter(Node<T>* prev_ptr, Args&&... args);
+
+    // @post other's nodes belong to node_alloc_ (moving their items into new nodes if
+    //       the allocators differ), ready to be relinked into this list
+    void adoptNodes(LinkedList<T, Allocator, DOUBLY_LINKED>& other);
+
+    // @post the list is empty without touching the nodes it held
+    void release();
+
 
 
 
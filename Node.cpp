@@ -29,6 +29,19 @@ Node<T>::Node(const T& an_item, Node<T>* next_node_ptr) :
 {
 } // end constructor
 
+//parameterized constructor, moving an_item in
+template<class T>
+Node<T>::Node(T&& an_item) : item_(std::move(an_item)), next_(nullptr)
+{
+} // end constructor
+
+//in-place constructor
+template<class T>
+template<class... Args>
+Node<T>::Node(std::in_place_t, Args&&... args) : item_(std::forward<Args>(args)...), next_(nullptr)
+{
+} // end constructor
+
 
 /** @param an_item contained in the node
  @post sets item_ to an_item */
@@ -38,6 +51,12 @@ void Node<T>::setItem(const T& an_item)
    item_ = an_item;
 } // end setItem
 
+template<class T>
+void Node<T>::setItem(T&& an_item)
+{
+   item_ = std::move(an_item);
+} // end setItem
+
 
 /** @param next_node_ptr points to the next node in the chain
  @post sets next_ to next_node_ptr */
@@ -54,6 +73,19 @@ T Node<T>::getItem() const
    return item_;
 } // end getItem
 
+ /**@return a reference to item_, without copying it*/
+template<class T>
+T& Node<T>::item()
+{
+   return item_;
+} // end item
+
+template<class T>
+const T& Node<T>::item() const
+{
+   return item_;
+} // end item
+
  /**@return next_*/
 template<class T>
 Node<T>* Node<T>::getNext() const
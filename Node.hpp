@@ -8,6 +8,8 @@
 #ifndef NODE_
 #define NODE_
 
+#include <utility>
+
 template<class T>
 class Node
 {
@@ -15,10 +17,17 @@ public:
    Node();  //default constructor
    Node(const T& an_item); //parameterized constructor
    Node(const T& an_item, Node<T>* next_node_ptr); //parameterized constructor
+   Node(T&& an_item); //parameterized constructor, moving an_item in
+
+   /** @param args arguments for T's constructor
+       @post item_ is constructed in place from args */
+   template<class... Args>
+   explicit Node(std::in_place_t, Args&&... args);
 
    /** @param an_item  contained in the node
         @post sets item_ to an_item */
    void setItem(const T& an_item);
+   void setItem(T&& an_item);
     
     /** @param next_node_ptr points to the next node in the chain
      @post sets next_ to next_node_ptr */
@@ -26,6 +35,10 @@ public:
     
     /**@return item_*/
    T getItem() const ;
+
+    /**@return a reference to item_, without copying it*/
+   T& item();
+   const T& item() const;
     
     /**@return next_*/
    Node<T>* getNext() const ;
@@ -0,0 +1,177 @@
+/*
+Slab allocator for linked-list nodes.
+*/
+
+#include "NodePool.hpp"
+#include <algorithm>
+#include <new>
+
+// ********* NodePool **************//
+
+template<class ItemType, int FIRST_SLAB_ITEMS>
+NodePool<ItemType, FIRST_SLAB_ITEMS>::NodePool(): free_(nullptr), next_(nullptr), end_(nullptr)
+{
+}  // end default constructor
+
+/** destructor: releases every slab, whether or not its blocks were given back **/
+template<class ItemType, int FIRST_SLAB_ITEMS>
+NodePool<ItemType, FIRST_SLAB_ITEMS>::~NodePool()
+{
+	std::allocator<Block> allocator;
+	for (size_t k = 0; k < slabs_.size(); k++)
+	{
+		allocator.deallocate(slabs_[k], slab_sizes_[k]);
+	}  // end for
+}  // end destructor
+
+/**
+ @return uninitialized memory for one ItemType, reusing a freed block if there is one
+ **/
+template<class ItemType, int FIRST_SLAB_ITEMS>
+ItemType* NodePool<ItemType, FIRST_SLAB_ITEMS>::allocate()
+{
+	if (free_)
+	{
+		FreeBlock* block = free_;
+		free_ = block->next_;
+		return reinterpret_cast<ItemType*>(block);
+	}  // end if
+
+	if (next_ == end_)
+	{
+		addSlab();
+	}  // end if
+	return reinterpret_cast<ItemType*>(next_++);
+}  // end allocate
+
+/**
+ @param block memory returned by allocate() on this pool, already destroyed
+ @post block is at the front of the free list
+ **/
+template<class ItemType, int FIRST_SLAB_ITEMS>
+void NodePool<ItemType, FIRST_SLAB_ITEMS>::deallocate(ItemType* block)
+{
+	FreeBlock* freed = ::new (static_cast<void*>(block)) FreeBlock;
+	freed->next_ = free_;
+	free_ = freed;
+}  // end deallocate
+
+// ********* PRIVATE METHODS **************//
+
+/** @post a new slab, twice the size of the last, is ready to hand out **/
+template<class ItemType, int FIRST_SLAB_ITEMS>
+void NodePool<ItemType, FIRST_SLAB_ITEMS>::addSlab()
+{
+	int size = slab_sizes_.empty() ? FIRST_SLAB_ITEMS : std::min(slab_sizes_.back() * 2, MAX_SLAB_ITEMS);
+
+	// Reserve the bookkeeping first so a failed push_back cannot leak the slab
+	slabs_.reserve(slabs_.size() + 1);
+	slab_sizes_.reserve(slab_sizes_.size() + 1);
+
+	std::allocator<Block> allocator;
+	Block* slab = allocator.allocate(size);
+	slabs_.push_back(slab);
+	slab_sizes_.push_back(size);
+	next_ = slab;
+	end_ = slab + size;
+}  // end addSlab
+
+// ********* PoolResource **************//
+
+/** @return the pool for ItemType, creating it if this is the first request **/
+template<int FIRST_SLAB_ITEMS>
+template<class ItemType>
+NodePool<ItemType, FIRST_SLAB_ITEMS>& PoolResource<FIRST_SLAB_ITEMS>::getPool()
+{
+	const void* key = typeKey<ItemType>();
+	for (const Entry& entry : pools_)
+	{
+		if (entry.type_key_ == key)
+		{
+			return *static_cast<NodePool<ItemType, FIRST_SLAB_ITEMS>*>(entry.pool_.get());
+		}  // end if
+	}  // end for
+
+	std::shared_ptr<NodePool<ItemType, FIRST_SLAB_ITEMS>> pool = std::make_shared<NodePool<ItemType, FIRST_SLAB_ITEMS>>();
+	pools_.push_back(Entry{key, pool});
+	return *pool;
+}  // end getPool
+
+/** @return an address unique to ItemType **/
+template<int FIRST_SLAB_ITEMS>
+template<class ItemType>
+const void* PoolResource<FIRST_SLAB_ITEMS>::typeKey()
+{
+	static const char key = 0;
+	return &key;
+}  // end typeKey
+
+// ********* PoolAllocator **************//
+
+/** allocator with a new, empty resource **/
+template<class ItemType, int FIRST_SLAB_ITEMS>
+PoolAllocator<ItemType, FIRST_SLAB_ITEMS>::PoolAllocator()
+	: resource_(std::make_shared<PoolResource<FIRST_SLAB_ITEMS>>())
+{
+	pool_ = &resource_->template getPool<ItemType>();
+}  // end default constructor
+
+/** allocator for ItemType sharing other's resource **/
+template<class ItemType, int FIRST_SLAB_ITEMS>
+template<class Other>
+PoolAllocator<ItemType, FIRST_SLAB_ITEMS>::PoolAllocator(const PoolAllocator<Other, FIRST_SLAB_ITEMS>& other)
+	: resource_(other.resource_)
+{
+	pool_ = &resource_->template getPool<ItemType>();
+}  // end rebinding constructor
+
+/**
+ @param count the number of objects to allocate
+ @return uninitialized memory for count objects
+ **/
+template<class ItemType, int FIRST_SLAB_ITEMS>
+ItemType* PoolAllocator<ItemType, FIRST_SLAB_ITEMS>::allocate(std::size_t count)
+{
+	if (count == 1)
+	{
+		return pool_->allocate();
+	}  // end if
+	return std::allocator<ItemType>().allocate(count);
+}  // end allocate
+
+/**
+ @param block memory from allocate(count) on an allocator equal to this one
+ @param count the same count passed to allocate
+ **/
+template<class ItemType, int FIRST_SLAB_ITEMS>
+void PoolAllocator<ItemType, FIRST_SLAB_ITEMS>::deallocate(ItemType* block, std::size_t count)
+{
+	if (count == 1)
+	{
+		pool_->deallocate(block);
+		return;
+	}  // end if
+	std::allocator<ItemType>().deallocate(block, count);
+}  // end deallocate
+
+/**
+ @return a new resource for the copy, so copied containers do not share slabs
+ **/
+template<class ItemType, int FIRST_SLAB_ITEMS>
+PoolAllocator<ItemType, FIRST_SLAB_ITEMS> PoolAllocator<ItemType, FIRST_SLAB_ITEMS>::select_on_container_copy_construction() const
+{
+	return PoolAllocator<ItemType, FIRST_SLAB_ITEMS>();
+}  // end select_on_container_copy_construction
+
+/** @return true if both allocators draw from the same resource **/
+template<class ItemType, int FIRST_SLAB_ITEMS>
+bool PoolAllocator<ItemType, FIRST_SLAB_ITEMS>::operator==(const PoolAllocator<ItemType, FIRST_SLAB_ITEMS>& rhs) const
+{
+	return resource_ == rhs.resource_;
+}  // end operator==
+
+template<class ItemType, int FIRST_SLAB_ITEMS>
+bool PoolAllocator<ItemType, FIRST_SLAB_ITEMS>::operator!=(const PoolAllocator<ItemType, FIRST_SLAB_ITEMS>& rhs) const
+{
+	return !(*this == rhs);
+}  // end operator!=
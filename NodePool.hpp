@@ -0,0 +1,155 @@
+/*
+Slab allocator for linked-list nodes.
+Nodes are carved out of slabs in the order they are requested, so a run of inserts lays
+its nodes out next to each other, and a freed node goes on a free list to be reused by
+the next insert in O(1). Slabs are only returned to the system when the pool is destroyed.
+*/
+
+#ifndef NODE_POOL_
+#define NODE_POOL_
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+/**
+    Pool of same-sized blocks, each big enough for one ItemType.
+    Slabs start at FIRST_SLAB_ITEMS blocks and double up to MAX_SLAB_ITEMS.
+**/
+template <class ItemType, int FIRST_SLAB_ITEMS = 64>
+class NodePool
+{
+   public:
+   NodePool();
+   NodePool(const NodePool<ItemType, FIRST_SLAB_ITEMS> &other) = delete;
+   NodePool<ItemType, FIRST_SLAB_ITEMS> &operator=(const NodePool<ItemType, FIRST_SLAB_ITEMS> &other) = delete;
+
+   /** destructor: releases every slab, whether or not its blocks were given back **/
+   ~NodePool();
+
+   /**
+       @return uninitialized memory for one ItemType, reusing a freed block if there is one
+   **/
+   ItemType *allocate();
+
+   /**
+       @param block memory returned by allocate() on this pool, already destroyed
+       @post block is at the front of the free list
+   **/
+   void deallocate(ItemType *block);
+
+   private:
+   static constexpr int MAX_SLAB_ITEMS = 4096;
+
+   /** A freed block, reusing its own storage for the free-list link **/
+   struct FreeBlock
+   {
+      FreeBlock *next_;
+   };
+
+   /** Storage for one block, big and aligned enough for an ItemType or a FreeBlock **/
+   union Block
+   {
+      FreeBlock free_;
+      alignas(ItemType) unsigned char item_[sizeof(ItemType)];
+   };
+
+   std::vector<Block *> slabs_;  // every slab allocated so far, with its size in slab_sizes_
+   std::vector<int> slab_sizes_;
+   FreeBlock *free_;             // most recently freed block, nullptr if none
+   Block *next_;                 // next never-used block in the newest slab
+   Block *end_;                  // one past the newest slab
+
+   /** @post a new slab, twice the size of the last, is ready to hand out **/
+   void addSlab();
+}; // end NodePool
+
+/**
+    Set of NodePools, one per item type, created on first use.
+    Lets allocators rebound to different types share one owner.
+**/
+template <int FIRST_SLAB_ITEMS = 64>
+class PoolResource
+{
+   public:
+   PoolResource() = default;
+   PoolResource(const PoolResource<FIRST_SLAB_ITEMS> &other) = delete;
+   PoolResource<FIRST_SLAB_ITEMS> &operator=(const PoolResource<FIRST_SLAB_ITEMS> &other) = delete;
+
+   /** @return the pool for ItemType, creating it if this is the first request **/
+   template <class ItemType>
+   NodePool<ItemType, FIRST_SLAB_ITEMS> &getPool();
+
+   private:
+   struct Entry
+   {
+      const void *type_key_;        // address unique to the pool's item type
+      std::shared_ptr<void> pool_;  // the NodePool, destroyed with its real type
+   };
+   std::vector<Entry> pools_;
+
+   /** @return an address unique to ItemType **/
+   template <class ItemType>
+   static const void *typeKey();
+}; // end PoolResource
+
+/**
+    Standard allocator handing out single objects from a shared PoolResource.
+    Copies and rebound copies share the resource and compare equal, so two lists built
+    from the same allocator can relink nodes between them; each default-constructed
+    allocator starts a resource of its own. Requests for more than one object go to
+    std::allocator.
+**/
+template <class ItemType, int FIRST_SLAB_ITEMS = 64>
+class PoolAllocator
+{
+   public:
+   typedef ItemType value_type;
+   typedef std::true_type propagate_on_container_move_assignment;
+   typedef std::true_type propagate_on_container_swap;
+
+   template <class Other>
+   struct rebind
+   {
+      typedef PoolAllocator<Other, FIRST_SLAB_ITEMS> other;
+   };
+
+   /** allocator with a new, empty resource **/
+   PoolAllocator();
+
+   /** allocator for ItemType sharing other's resource **/
+   template <class Other>
+   PoolAllocator(const PoolAllocator<Other, FIRST_SLAB_ITEMS> &other);
+
+   /**
+       @param count the number of objects to allocate
+       @return uninitialized memory for count objects
+   **/
+   ItemType *allocate(std::size_t count);
+
+   /**
+       @param block memory from allocate(count) on an allocator equal to this one
+       @param count the same count passed to allocate
+   **/
+   void deallocate(ItemType *block, std::size_t count);
+
+   /**
+       @return a new resource for the copy, so copied containers do not share slabs
+   **/
+   PoolAllocator<ItemType, FIRST_SLAB_ITEMS> select_on_container_copy_construction() const;
+
+   /** @return true if both allocators draw from the same resource **/
+   bool operator==(const PoolAllocator<ItemType, FIRST_SLAB_ITEMS> &rhs) const;
+   bool operator!=(const PoolAllocator<ItemType, FIRST_SLAB_ITEMS> &rhs) const;
+
+   private:
+   template <class Other, int SLAB_ITEMS>
+   friend class PoolAllocator;
+
+   std::shared_ptr<PoolResource<FIRST_SLAB_ITEMS>> resource_;
+   NodePool<ItemType, FIRST_SLAB_ITEMS> *pool_;  // resource_'s pool for ItemType
+}; // end PoolAllocator
+
+#include "NodePool.cpp"
+#endif
@@ -0,0 +1,113 @@
+/*
+Benchmark for NodePool, through LinkedList<int> with the default heap allocator against
+LinkedList<int, PoolAllocator<int>>. Times four workloads:
+  insert    1M push_backs onto an empty list
+  remove    1M remove(0)s, emptying that list
+  churn     2M operations alternating push_back and remove(0) on a list of 1000 items
+  traverse  20 full iterations of a 1M-item list that was built alternately with another
+            list, so heap nodes from the two lists sit interleaved
+Build and run with `make nodepool_bench && ./nodepool_bench`.
+*/
+
+#include "LinkedList.hpp"
+#include "NodePool.hpp"
+#include <chrono>
+#include <cstdio>
+
+static const int ITEMS = 1000000;
+static const int CHURN_OPERATIONS = 2000000;
+static const int CHURN_LENGTH = 1000;
+static const int TRAVERSALS = 20;
+
+// Stops the compiler from dropping traversals whose sums are unused
+static volatile long long sink;
+
+/*
+    @param work called once
+    @return seconds work took
+*/
+template<class Work>
+static double timeWork(Work work)
+{
+	auto start = std::chrono::steady_clock::now();
+	work();
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/*
+    @param name the list being timed
+    @post prints the throughput of every workload on a List, in millions of items per second
+*/
+template<class List>
+static void benchList(const char* name)
+{
+	double insert_seconds;
+	double remove_seconds;
+	{
+		List list;
+		insert_seconds = timeWork([&]() {
+			for (int i = 0; i < ITEMS; i++)
+			{
+				list.push_back(i);
+			}  // end for
+		});
+		remove_seconds = timeWork([&]() {
+			while (list.remove(0))
+			{
+			}  // end while
+		});
+	}
+
+	double churn_seconds;
+	{
+		List list;
+		for (int i = 0; i < CHURN_LENGTH; i++)
+		{
+			list.push_back(i);
+		}  // end for
+		churn_seconds = timeWork([&]() {
+			for (int i = 0; i < CHURN_OPERATIONS; i += 2)
+			{
+				list.push_back(i);
+				list.remove(0);
+			}  // end for
+		});
+	}
+
+	double traverse_seconds;
+	{
+		List list;
+		List other;
+		for (int i = 0; i < ITEMS; i++)
+		{
+			list.push_back(i);
+			other.push_back(i);
+		}  // end for
+
+		const List& reader = list;
+		traverse_seconds = timeWork([&]() {
+			for (int t = 0; t < TRAVERSALS; t++)
+			{
+				long long sum = 0;
+				for (int item : reader)
+				{
+					sum += item;
+				}  // end for
+				sink = sum;
+			}  // end for
+		});
+	}
+
+	std::printf("%s\n", name);
+	std::printf("  insert   %8.2f M/s\n", ITEMS / insert_seconds / 1e6);
+	std::printf("  remove   %8.2f M/s\n", ITEMS / remove_seconds / 1e6);
+	std::printf("  churn    %8.2f M/s\n", CHURN_OPERATIONS / churn_seconds / 1e6);
+	std::printf("  traverse %8.2f M/s\n", double(TRAVERSALS) * ITEMS / traverse_seconds / 1e6);
+}
+
+int main()
+{
+	benchList<LinkedList<int>>("LinkedList<int>, heap nodes");
+	benchList<LinkedList<int, PoolAllocator<int>>>("LinkedList<int, PoolAllocator<int>>, pooled nodes");
+	return 0;
+}
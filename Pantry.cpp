@@ -1,36 +1,305 @@
 #include "Pantry.hpp"
 #include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Helpers for reading and writing files, private to this file
+namespace {
+
+/*
+    Read-only view of a whole file, mapped into memory for as long as it lives
+*/
+class MappedFile {
+    public:
+        /*
+            @param The name of the file
+            @throws std::runtime_error if it cannot be opened or mapped
+        */
+        explicit MappedFile(const std::string& path) : data_(nullptr), size_(0) {
+            int fd = open(path.c_str(), O_RDONLY);
+            if (fd < 0) {
+                throw std::runtime_error("Failed to open file: " + path);
+            }
+
+            struct stat info;
+            if (fstat(fd, &info) != 0) {
+                close(fd);
+                throw std::runtime_error("Failed to open file: " + path);
+            }
+            size_ = static_cast<size_t>(info.st_size);
+
+            // An empty file has nothing to map
+            if (size_ > 0) {
+                void* mapped = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (mapped == MAP_FAILED) {
+                    close(fd);
+                    throw std::runtime_error("Failed to map file: " + path);
+                }
+                madvise(mapped, size_, MADV_SEQUENTIAL);
+                data_ = static_cast<const char*>(mapped);
+            }
+            // The mapping outlives the descriptor
+            close(fd);
+        }
+
+        MappedFile(const MappedFile& other) = delete;
+        MappedFile& operator=(const MappedFile& other) = delete;
+
+        ~MappedFile() {
+            if (data_) {
+                munmap(const_cast<char*>(data_), size_);
+            }
+        }
+
+        /*
+            @return The whole file
+        */
+        std::string_view contents() const {
+            return std::string_view(data_, size_);
+        }
+
+    private:
+        const char* data_;
+        size_t size_;
+};
+
+/*
+    One row of a catalog, viewing the text of the mapped file
+*/
+struct CatalogRow {
+    std::string_view name_;
+    std::string_view description_;
+    int quantity_;
+    int price_;
+    std::string_view recipe_;   // ingredient names separated by spaces, empty for NONE
+};
+
+/*
+    @param The text to take a line from, advanced past the line
+    @return The line, without its line ending or trailing whitespace
+*/
+std::string_view nextLine(std::string_view& text) {
+    size_t end = text.find('\n');
+    std::string_view line = text.substr(0, end);
+    text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+
+    // INFO: Needed to pass gradescope (maybe line ending but necessary either way)
+    while (!line.empty() && std::isspace(static_cast<unsigned char>(line.back()))) {
+        line.remove_suffix(1);
+    }
+    return line;
+}
+
+/*
+    @param A cell holding a count, possibly padded with spaces
+    @param Set to the count
+    @return True if the cell is a non negative integer
+*/
+bool parseCount(std::string_view cell, int& value) {
+    size_t first = cell.find_first_not_of(' ');
+    if (first == std::string_view::npos) {
+        return false;
+    }
+    cell = cell.substr(first, cell.find_last_not_of(' ') - first + 1);
+
+    std::from_chars_result result = std::from_chars(cell.data(), cell.data() + cell.size(), value);
+    return result.ec == std::errc() && result.ptr == cell.data() + cell.size() && value >= 0;
+}
+
+/*
+    @param A non empty line of a catalog, without its line ending
+    @param Filled in with the cells of the line
+    @return nullptr if the line is a valid row, otherwise what is wrong with it
+*/
+const char* parseCatalogRow(std::string_view line, CatalogRow& row) {
+    // Anything after a semicolon is not part of the row
+    line = line.substr(0, line.find(';'));
+
+    std::string_view cells[5];
+    for (int c = 0; c < 5; c++) {
+        size_t comma = line.find(',');
+        if (comma == std::string_view::npos && c < 4) {
+            return "expected Name,Description,Quantity,Price,Recipe";
+        }
+        cells[c] = line.substr(0, comma);
+        line.remove_prefix(comma == std::string_view::npos ? line.size() : comma + 1);
+    }
+
+    if (cells[0].empty()) {
+        return "missing name";
+    }
+    if (!parseCount(cells[2], row.quantity_)) {
+        return "quantity is not a non negative integer";
+    }
+    if (!parseCount(cells[3], row.price_)) {
+        return "price is not a non negative integer";
+    }
+    row.name_ = cells[0];
+    row.description_ = cells[1];
+    // Handle `NONE` cell
+    row.recipe_ = (cells[4].substr(0, 4) == "NONE") ? std::string_view() : cells[4];
+    return nullptr;
+}
+
+// Catalogs are only split across threads in pieces at least this big
+const size_t MIN_CHUNK_BYTES = 64 * 1024;
 
 /*
-    @param A const string reference to be parsed
-    @param A char to be split upon
-    @return A vector of split substrings without the delimiter
+    A run of whole lines of a catalog, parsed by one thread
 */
-std::vector<std::string> split(const std::string& s, char delim){
-    std::vector<std::string> result;
-    std::stringstream ss(s);
-    std::string buf;
-    while (std::getline(ss, buf, delim)) {
-        result.push_back(buf);
+struct CatalogChunk {
+    std::string_view text_;
+    std::vector<CatalogRow> rows_;
+    std::vector<Ingredient*> ingredients_;  // made for rows_, in the same order, once every row is valid
+    size_t lines_ = 0;                      // lines of text_ read, blank ones included
+    const char* problem_ = nullptr;         // what is wrong with line lines_, if anything
+};
+
+/*
+    @param A chunk with text_ set
+    @post The lines of text_ are parsed into rows_ and their ingredients made, unless a row is
+        malformed: then parsing stops there, with problem_ set and nothing made
+*/
+void parseCatalogChunk(CatalogChunk& chunk) {
+    std::string_view text = chunk.text_;
+    while (!text.empty()) {
+        std::string_view line = nextLine(text);
+        chunk.lines_++;
+        if (line.empty()) {
+            continue;
+        }
+
+        CatalogRow row;
+        chunk.problem_ = parseCatalogRow(line, row);
+        if (chunk.problem_) {
+            return;
+        }
+        chunk.rows_.push_back(row);
+    }
+
+    chunk.ingredients_.reserve(chunk.rows_.size());
+    for (const CatalogRow& row : chunk.rows_) {
+        chunk.ingredients_.push_back(new Ingredient { std::string(row.name_), std::string(row.description_),
+                                                      row.quantity_, row.price_, {} });
     }
-    return result;
 }
 
 /*
-    @param A string to be trimmed
-    @post Trims whitespace from param
-    @note Taken from https://stackoverflow.com/a/217605
+    @param How many pieces of work there are
+    @param Called as work(k) for every k in [0, count), each on its own thread (the last on this one)
+    @post Every call has finished. If any threw, the exception of the lowest k is rethrown.
 */
-inline void rtrim(std::string &s) {
-    s.erase(std::find_if(s.rbegin(), s.rend(), [](unsigned char ch) {
-        return !std::isspace(ch);
-    }).base(), s.end());
+template <class Work>
+void inParallel(size_t count, const Work& work) {
+    std::vector<std::exception_ptr> failures(count);
+    auto run = [&](size_t k) {
+        try {
+            work(k);
+        } catch (...) {
+            failures[k] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t k = 0; k + 1 < count; k++) {
+        threads.emplace_back(run, k);
+    }
+    if (count > 0) {
+        run(count - 1);
+    }
+    for (std::thread& t : threads) {
+        t.join();
+    }
+
+    for (const std::exception_ptr& failure : failures) {
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+    }
+}
+
+/*
+    Snapshot layout, in host byte order:
+        SnapshotHeader
+        SnapshotIngredient[ingredient_count_]   the pantry in list order, then what their recipes name outside it
+        uint32_t[edge_count_]                   recipe entries, as indices into the table
+        char[pool_size_]                        names and descriptions, back to back
+    Every section is a multiple of 4 bytes, so a mapped snapshot can be read where it lies.
+*/
+const char SNAPSHOT_MAGIC[8] = { 'P', 'A', 'N', 'T', 'R', 'Y', 'S', 'N' };
+const uint32_t SNAPSHOT_VERSION = 1;
+const uint32_t SNAPSHOT_IN_PANTRY = 1;  // flag for ingredients that are in the pantry itself
+
+struct SnapshotHeader {
+    char magic_[8];
+    uint32_t version_;
+    uint32_t ingredient_count_;
+    uint32_t edge_count_;
+    uint32_t pool_size_;
+    uint64_t checksum_;     // of everything after the header
+};
+
+struct SnapshotIngredient {
+    uint32_t name_offset_;
+    uint32_t name_length_;
+    uint32_t description_offset_;
+    uint32_t description_length_;
+    int32_t quantity_;
+    int32_t price_;
+    uint32_t recipe_begin_;     // first of its entries in the edge array
+    uint32_t recipe_count_;
+    uint32_t flags_;
+};
+
+/*
+    @param The bytes to add
+    @param How many there are
+    @param The checksum of the bytes before them
+    @return The 64-bit FNV-1a checksum with the bytes added
+*/
+uint64_t snapshotChecksum(const char* data, size_t size, uint64_t hash = 14695981039346656037ull) {
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * 1099511628211ull;
+    }
+    return hash;
 }
 
+/*
+    @param The snapshot's ingredient table
+    @param The index of a record in it
+    @return A copy of the record, read from where it lies in the table
+*/
+SnapshotIngredient snapshotRecord(const char* table, size_t id) {
+    SnapshotIngredient record;
+    std::memcpy(&record, table + id * sizeof(SnapshotIngredient), sizeof(record));
+    return record;
+}
+
+}  // namespace
+
 /**
    Default Constructor
 */
-Pantry::Pantry() : LinkedList<Ingredient*>() {}
+Pantry::Pantry() : PantryList(), positions_stale_(false) {}
+
+/**
+   Copy Constructor
+   @post: Holds the same Ingredient pointers in the same order as other
+*/
+Pantry::Pantry(const Pantry& other) : PantryList(other), positions_stale_(false) {
+    // The copied entries would refer to other's nodes, so index this list's own
+    rebuildIndex();
+}
 
 /**
     @param: the name of an input file
@@ -62,47 +331,20 @@ Pantry::Pantry() : LinkedList<Ingredient*>() {}
         Hint: update as needed using addIngredient()
 
     @post: Each line of the input file corresponds to a ingredient to be added to the list. No duplicates are allowed.
-    Hint: use std::ifstream and getline()
-*/
-Pantry::Pantry(const std::string& path) {
-    std::ifstream f { path };
-    if (!f.is_open()) {
-        throw std::runtime_error("Failed to open file: " + path);
-    }
-
-    std::string line;
-    std::getline(f, line);
-
-    // Add a new ingredient per each line
-    while (std::getline(f, line)) {
-        // INFO: Needed to pass gradescope (maybe line ending but necessary either way)
-        rtrim(line);
-        // Get cells in that CSV row without the semicolon
-        std::vector<std::string> cells = split(split(line, ';')[0], ',');
-
-        std::string name = cells[0];
-        std::string desc = cells[1];
-        int quantity = std::stoi(cells[2]);
-        int price = std::stoi(cells[3]);
-        std::vector<Ingredient*> recipe;
-
-        // Handle `NONE` cell
-        if (cells[4].substr(0, 4) != "NONE") {
-            std::vector<std::string> recipe_ingredients = split(cells[4], ' ');
-            for (size_t i = 0; i < recipe_ingredients.size(); i++) {
-                Ingredient* ingredient = getIngredient(recipe_ingredients[i]);
-
-                // SAFETY: Handle nullptr if it doesn't exist!
-                if (ingredient) {
-                    recipe.push_back(ingredient);
-                }
-            }
-        }
+            A recipe may name an ingredient defined later in the file; names defined nowhere are left out of the recipe.
+    @throws: std::runtime_error if the file cannot be opened, or "[path]:[line]: [problem]" for a malformed row
+*/
+Pantry::Pantry(const std::string& path) : positions_stale_(false) {
+    loadCatalog(path, 1);
+}
 
-        // Can be checked for existence in subsequent loops
-        // HAXX: Assumes no duplicates (woiuld need to sum quantities and add fast path)
-        addIngredient(name, desc, quantity, price, recipe);
-    }
+/**
+    @param: the name of an input file, in the format Pantry(path) describes
+    @param: how many threads to parse it with, 0 for one per core
+    @post: The same ingredients, in the same order, as Pantry(path)
+*/
+Pantry::Pantry(const std::string& path, unsigned threads) : positions_stale_(false) {
+    loadCatalog(path, threads);
 }
 
  /**
@@ -110,7 +352,9 @@ Pantry::Pantry(const std::string& path) {
         @post: Explicitly deletes every dynamically allocated Ingredient object
 */
 Pantry::~Pantry() {
-    LinkedList::clear();
+    PantryList::clear();
+    index_.clear();
+    craft_.clear();
 }
 
 /**
@@ -118,20 +362,17 @@ Pantry::~Pantry() {
     @return: The integer position of the given ingredient if it is in the Pantry, -1 if not found. REMEMBER, indexing starts at 0.
 */
 int Pantry::getPosOf(const std::string& ingredient) const {
-    Node<Ingredient*>* head_ptr = LinkedList::getHeadNode();
-    size_t pos = 0;
-
-    // Return first instance of ingredient
-    while (head_ptr) {
-        if (head_ptr->getItem()->name_ == ingredient) {
-            return pos;
-        }
-        head_ptr = head_ptr->getNext();
-        pos++;
+    std::lock_guard<PantryIndexMutex> lock(index_mutex_);
+    auto found = index_.find(ingredient);
+    if (found == index_.end()) {
+        // Not found
+        return -1;
     }
 
-    // Not found
-    return -1;
+    if (positions_stale_) {
+        refreshPositions();
+    }
+    return found->second.position_;
 }
 
 /**
@@ -139,8 +380,8 @@ int Pantry::getPosOf(const std::string& ingredient) const {
     @return: True if the ingredient information is already in the Pantry
 */
 bool Pantry::contains(const std::string& ingredient) const {
-    // `getPosOf` returns -1 if it doesn't exist
-    return getPosOf(ingredient) != -1;
+    std::lock_guard<PantryIndexMutex> lock(index_mutex_);
+    return index_.count(ingredient) != 0;
 }
 
 /**
@@ -155,11 +396,29 @@ bool Pantry::addIngredient(Ingredient* ingredient) {
         return false;
     }
 
-    if (!contains(ingredient->name_)) {
-
-        return LinkedList::insert(LinkedList::getLength(), ingredient);
+    // Check and add under one lock, so two adds of the same name cannot both succeed
+    std::lock_guard<PantryIndexMutex> lock(index_mutex_);
+    if (index_.count(ingredient->name_) != 0) {
+        return false;
     }
-    return false;
+
+    // Appending leaves every other position as it was
+    IndexEntry entry;
+    entry.ingredient_ = ingredient;
+    entry.position_ = PantryList::getLength();
+#if defined(PANTRY_HANDLES)
+    entry.handle_ = PantryList::push_back(ingredient);
+#else
+    PantryList::push_back(ingredient);
+#endif
+    index_.emplace(ingredient->name_, entry);
+
+    // Recipes that named it while it was missing may be possible now
+    std::vector<Ingredient*> seeds = dependentsOf(ingredient);
+    seeds.push_back(ingredient);
+    linkCraftNode(ingredient);
+    updateCraftable(seeds);
+    return true;
 }
 
 /**
@@ -178,51 +437,136 @@ bool Pantry::addIngredient(const std::string& name, const std::string& descripti
     return addIngredient(i);
 }
 
+/**
+    @param: A const string reference to a ingredient name
+    @post: The ingredient is no longer in the Pantry. It is not deleted, since other ingredients' recipes may still point to it.
+    @return: A pointer to the removed Ingredient, which the caller now owns. nullptr if it was not in the Pantry.
+*/
+Ingredient* Pantry::removeIngredient(const std::string& name) {
+    std::lock_guard<PantryIndexMutex> lock(index_mutex_);
+    auto found = index_.find(name);
+    if (found == index_.end()) {
+        return nullptr;
+    }
+
+    Ingredient* removed = found->second.ingredient_;
+#if defined(PANTRY_HANDLES)
+    // O(1) unlink through the node's handle
+    PantryList::erase(found->second.handle_);
+#else
+    if (positions_stale_) {
+        refreshPositions();
+    }
+    PantryList::remove(found->second.position_);
+#endif
+
+    // Everything after the removed ingredient moved up one; removing the last moves nothing
+    if (found->second.position_ != PantryList::getLength()) {
+        positions_stale_ = true;
+    }
+    index_.erase(found);
+
+    unlinkCraftNode(removed);
+    updateCraftable(dependentsOf(removed));
+    return removed;
+}
+
+/**
+    @param: A const string reference to a ingredient name
+    @param: The new quantity, a non negative integer
+    @post: The ingredient's quantity is set. When it goes from 0 to some or back, only the
+            ingredients whose recipes depend on it have their craftability worked out again.
+            Quantities of ingredients in the pantry must be changed through here (and recipes
+            not at all) for canCreate to stay correct.
+    @return: True if the quantity was set, false if the ingredient is not in the Pantry or quantity is negative
+*/
+bool Pantry::setQuantity(const std::string& name, int quantity) {
+    if (quantity < 0) {
+        return false;
+    }
+
+    std::lock_guard<PantryIndexMutex> lock(index_mutex_);
+    auto found = index_.find(name);
+    if (found == index_.end()) {
+        return false;
+    }
+
+    Ingredient* i = found->second.ingredient_;
+    bool had_some = i->quantity_ > 0;
+    i->quantity_ = quantity;
+
+    // Recipes only care whether there is any, so other changes affect nobody
+    if (had_some != (quantity > 0)) {
+        updateCraftable(dependentsOf(i));
+    }
+    return true;
+}
+
 /*
     @param A const string reference reresenting an ingredient name
     @return A reference to the Ingredient if the ingredient is in the pantry.
 */
 Ingredient* Pantry::getIngredient(const std::string& name) const {
-    size_t pos = getPosOf(name);
-    if (pos == -1) {
-        return nullptr;
-    }
-    Ingredient* res = LinkedList::getEntry(pos);
+    std::lock_guard<PantryIndexMutex> lock(index_mutex_);
+    auto found = index_.find(name);
+    return (found == index_.end()) ? nullptr : found->second.ingredient_;
+}
+
+/*
+    @return Iterators over the ingredients, in list order. Only const iterators are
+        handed out, so the list can only change through the Pantry's own methods.
+*/
+PantryList::const_iterator Pantry::begin() const {
+    return PantryList::begin();
+}
+
+PantryList::const_iterator Pantry::end() const {
+    return PantryList::end();
+}
 
-    // SAFETY: Already checked if it exists in `getPosOf`
-    return res;
+/*
+    @param A position in the list, indexing from 0
+    @return A pointer to the Ingredient pointer at position, which cannot be reassigned through it. nullptr if position is not valid
+*/
+Ingredient* const* Pantry::tryGetEntry(int position) const {
+    return PantryList::tryGetEntry(position);
 }
 
 /**
     @param:  A Ingredient pointer
     @return: A boolean indicating if all the given ingredient can be created (all of the ingredients in its recipe can be created, or if you have enough of each ingredient in its recipe to create it)
+    @note: O(1) for an ingredient in the pantry, read from the craftability that updateCraftable keeps up to date.
+            Its counting pass is what makes recipes that need themselves uncraftable instead of endless.
+            Other ingredients take one pass over their recipe.
 */
-bool Pantry::canCreate(Ingredient* ingredient) const  {
+bool Pantry::canCreate(Ingredient* ingredient) const {
     // SAFETY: Handle nullptr
     if (!ingredient) {
         throw std::invalid_argument("Passed nullptr");
     }
 
-    // Has no recipe
-    if (ingredient->recipe_.size() == 0) {
-        return false;
+    std::lock_guard<PantryIndexMutex> lock(index_mutex_);
+    auto tracked = craft_.find(ingredient);
+    if (tracked != craft_.end() && tracked->second.member_) {
+        return tracked->second.craftable_;
     }
 
-    for (size_t i = 0; i < ingredient->recipe_.size(); i++) {
-        Ingredient* req_ingredient = ingredient->recipe_[i];
-
-        // Return early if the pantry doesn't have it or if the ingredients can't be created
-        if (contains(req_ingredient->name_)) {
-            // Can't make more of ingredient
-            if (req_ingredient->quantity_ == 0 && !canCreate(req_ingredient)) {
-                return false;
-            }
-        } else {
+    // Only ingredients in the pantry count, and their craftability is already tracked,
+    // so one pass over the recipe decides
+    const std::vector<Ingredient*>& recipe = ingredient->recipe_;
+    bool craftable = !recipe.empty();
+    for (size_t i = 0; craftable && i < recipe.size(); i++) {
+        Ingredient* req_ingredient = recipe[i];
+        auto req = craft_.find(req_ingredient);
+        if (req == craft_.end() || !req->second.member_) {
             // Does not have ingredient in pantry
-            return false;
+            craftable = false;
+        } else if (req_ingredient->quantity_ == 0) {
+            // Can't use what we have, so it has to be crafted itself
+            craftable = req->second.craftable_;
         }
     }
-    return true;
+    return craftable;
 }
 
 /**
@@ -373,16 +717,11 @@ void Pantry::recipeIngredientQuery(Ingredient* i) const {
     Note: This should only include price values from ingredients that you have 1 or more of. Do not consider ingredients that you have 0 of, even if you have the ingredients to make them.
 */
 int Pantry::calculatePantryValue() const {
-    Node<Ingredient*>* head_ptr = LinkedList::getHeadNode();
     size_t sum = 0;
-    while (head_ptr) {
-        Ingredient* i = head_ptr->getItem();
+    for (Ingredient* i : *this) {
         if (i->quantity_ != 0) {
             sum += i->quantity_ * i->price_;
         }
-
-        // Iterate
-        head_ptr = head_ptr->getNext();
     }
     return sum;
 }
@@ -406,50 +745,543 @@ int Pantry::calculatePantryValue() const {
 */
 void Pantry::pantryList(const std::string& filter) const {
     if (filter == "NONE") {
-        Node<Ingredient*>* head_ptr = LinkedList::getHeadNode();
-        while (head_ptr) {
-            Ingredient* i = head_ptr->getItem();
+        for (Ingredient* i : *this) {
             printIngredient(i);
-
-            // Iterate
-            head_ptr = head_ptr->getNext();
         }
     } else if (filter == "CONTAINS") {
-        Node<Ingredient*>* head_ptr = LinkedList::getHeadNode();
-        while (head_ptr) {
-            Ingredient* i = head_ptr->getItem();
+        for (Ingredient* i : *this) {
             if (i->quantity_ > 0) {
                 printIngredient(i);
             }
-
-            // Iterate
-            head_ptr = head_ptr->getNext();
         }
     } else if (filter == "MISSING") {
-        Node<Ingredient*>* head_ptr = LinkedList::getHeadNode();
-        while (head_ptr) {
-            Ingredient* i = head_ptr->getItem();
-
+        for (Ingredient* i : *this) {
             if (i->quantity_ == 0) {
                 printIngredient(i);
             }
-
-            // Iterate
-            head_ptr = head_ptr->getNext();
         }
     } else if (filter == "CRAFTABLE") {
-        Node<Ingredient*>* head_ptr = LinkedList::getHeadNode();
-        while (head_ptr) {
-            Ingredient* i = head_ptr->getItem();
+        for (Ingredient* i : *this) {
             if (canCreate(i)) {
                 printIngredient(i);
             }
-
-            // Iterate
-            head_ptr = head_ptr->getNext();
         }
     } else {
         std::cout << "INVALID FILTER\n";
     }
 }
 
+/**
+    @param: A const string reference to a sort order, "NAME" or "PRICE"
+    @post: The ingredients are reordered in place by name, or by ascending price.
+        Ingredients that compare equal keep their current order, and later pantryList calls print in the new order.
+    @return: True if the pantry was sorted, false if the order is invalid (the pantry is left unchanged)
+*/
+bool Pantry::sortIngredients(const std::string& order) {
+    std::lock_guard<PantryIndexMutex> lock(index_mutex_);
+    if (order == "NAME") {
+        PantryList::sort([](const Ingredient* a, const Ingredient* b) { return a->name_ < b->name_; });
+    } else if (order == "PRICE") {
+        PantryList::sort([](const Ingredient* a, const Ingredient* b) { return a->price_ < b->price_; });
+    } else {
+        return false;
+    }
+    positions_stale_ = true;
+    return true;
+}
+
+/*
+    @pre index_mutex_ is held
+    @post Every entry's position_ matches the list again and positions_stale_ is false
+*/
+void Pantry::refreshPositions() const {
+    int pos = 0;
+    for (Ingredient* i : *this) {
+        index_.find(i->name_)->second.position_ = pos++;
+    }
+    positions_stale_ = false;
+}
+
+/*
+    @post index_ holds an entry for every ingredient in the list (and nothing else), and craft_ matches
+*/
+void Pantry::rebuildIndex() {
+    index_.clear();
+    craft_.clear();
+#if defined(PANTRY_HANDLES)
+    for (PantryList::iterator it = PantryList::begin(); it != PantryList::end(); ++it) {
+        index_.emplace((*it)->name_, IndexEntry { *it, static_cast<int>(index_.size()), it.handle() });
+    }
+#else
+    for (Ingredient* i : *this) {
+        index_.emplace(i->name_, IndexEntry { i, static_cast<int>(index_.size()) });
+    }
+#endif
+    positions_stale_ = false;
+
+    std::vector<Ingredient*> all;
+    for (Ingredient* i : *this) {
+        linkCraftNode(i);
+        all.push_back(i);
+    }
+    updateCraftable(all);
+}
+
+/*
+    @param Ingredients to append, in order
+    @post Each one is appended and indexed as addIngredient would, under one lock, and
+        craftability is then worked out once for all of them, as rebuildIndex does.
+        An ingredient whose name is already in the pantry is skipped and stays the caller's.
+*/
+void Pantry::addIngredients(const std::vector<Ingredient*>& ingredients) {
+    std::lock_guard<PantryIndexMutex> lock(index_mutex_);
+    index_.reserve(index_.size() + ingredients.size());
+    craft_.reserve(craft_.size() + ingredients.size());
+
+    std::vector<Ingredient*> seeds;
+    seeds.reserve(ingredients.size());
+    for (Ingredient* ingredient : ingredients) {
+        // Appending leaves every other position as it was
+        auto added = index_.emplace(ingredient->name_, IndexEntry { ingredient, PantryList::getLength() });
+        if (!added.second) {
+            continue;
+        }
+#if defined(PANTRY_HANDLES)
+        added.first->second.handle_ = PantryList::push_back(ingredient);
+#else
+        PantryList::push_back(ingredient);
+#endif
+        linkCraftNode(ingredient);
+        seeds.push_back(ingredient);
+    }
+
+    // Recipes already in the pantry that named one of them while it was missing may be possible now
+    size_t added_count = seeds.size();
+    for (size_t k = 0; k < added_count; k++) {
+        for (const CraftNode* user : craft_[seeds[k]].used_by_) {
+            seeds.push_back(user->ingredient_);
+        }
+    }
+    updateCraftable(seeds);
+}
+
+/*
+    @pre index_mutex_ is held and ingredient has just been added to the list
+    @post ingredient is a member, and listed in used_by_ of each of its recipe ingredients
+*/
+void Pantry::linkCraftNode(Ingredient* ingredient) {
+    CraftNode& node = craft_[ingredient];
+    node.ingredient_ = ingredient;
+    node.member_ = true;
+    node.craftable_ = false;
+    for (Ingredient* req_ingredient : ingredient->recipe_) {
+        CraftNode& req = craft_[req_ingredient];
+        req.ingredient_ = req_ingredient;
+        req.used_by_.push_back(&node);
+    }
+}
+
+/*
+    @pre index_mutex_ is held and ingredient has just been removed from the list
+    @post ingredient is no longer a member, nor listed in any used_by_
+*/
+void Pantry::unlinkCraftNode(Ingredient* ingredient) {
+    CraftNode& node = craft_[ingredient];
+    node.member_ = false;
+    for (Ingredient* req_ingredient : ingredient->recipe_) {
+        auto req = craft_.find(req_ingredient);
+        if (req == craft_.end()) {
+            // Already dropped, when the recipe lists it twice
+            continue;
+        }
+        std::vector<CraftNode*>& used_by = req->second.used_by_;
+        used_by.erase(std::remove(used_by.begin(), used_by.end(), &node), used_by.end());
+
+        // Nothing left to track for an ingredient outside the pantry that nobody uses.
+        // A recipe that lists its own ingredient leaves that node to the check below.
+        if (req_ingredient != ingredient && !req->second.member_ && used_by.empty()) {
+            craft_.erase(req);
+        }
+    }
+
+    if (node.used_by_.empty()) {
+        craft_.erase(ingredient);
+    }
+}
+
+/*
+    @pre index_mutex_ is held
+    @param Pantry ingredients whose recipe inputs changed
+    @post craftable_ is correct again for seeds and for everything that depends on them
+        through ingredients you have none of. Nothing else is visited, so the cost is
+        O(affected subgraph). Ingredients that need themselves cannot be created.
+*/
+void Pantry::updateCraftable(const std::vector<Ingredient*>& seeds) {
+    // Nodes of the affected ingredients. A node's waiting_ counts the recipe entries still
+    // waiting on another affected ingredient, or is -1 once it is known it cannot be created.
+    std::vector<CraftNode*> affected;
+    for (Ingredient* i : seeds) {
+        auto node = craft_.find(i);
+        if (node != craft_.end() && node->second.member_ && !node->second.affected_) {
+            node->second.affected_ = true;
+            affected.push_back(&node->second);
+        }
+    }
+
+    // A change only passes on through ingredients you have none of, since a recipe
+    // that can use what you have doesn't care whether it could also be crafted
+    for (size_t k = 0; k < affected.size(); k++) {
+        if (affected[k]->ingredient_->quantity_ > 0) {
+            continue;
+        }
+        for (CraftNode* dependent : affected[k]->used_by_) {
+            if (!dependent->affected_) {
+                dependent->affected_ = true;
+                affected.push_back(dependent);
+            }
+        }
+    }
+
+    // Work the affected ingredients out together: each becomes craftable once every
+    // affected ingredient it waits on has, so any that wait on each other never do
+    std::vector<CraftNode*> ready;
+    for (CraftNode* node : affected) {
+        const std::vector<Ingredient*>& recipe = node->ingredient_->recipe_;
+        node->craftable_ = false;
+        node->waiting_ = 0;
+        bool possible = !recipe.empty();
+        for (size_t x = 0; possible && x < recipe.size(); x++) {
+            Ingredient* req_ingredient = recipe[x];
+            auto req = craft_.find(req_ingredient);
+            if (req == craft_.end() || !req->second.member_) {
+                // Does not have ingredient in pantry
+                possible = false;
+            } else if (req_ingredient->quantity_ == 0) {
+                if (req->second.affected_) {
+                    node->waiting_++;
+                } else {
+                    possible = req->second.craftable_;
+                }
+            }
+        }
+
+        if (!possible) {
+            node->waiting_ = -1;
+        } else if (node->waiting_ == 0) {
+            ready.push_back(node);
+        }
+    }
+
+    while (!ready.empty()) {
+        CraftNode* node = ready.back();
+        ready.pop_back();
+        node->craftable_ = true;
+        if (node->ingredient_->quantity_ > 0) {
+            // Nobody was waiting on it
+            continue;
+        }
+        for (CraftNode* dependent : node->used_by_) {
+            if (dependent->affected_ && dependent->waiting_ > 0 && --dependent->waiting_ == 0) {
+                ready.push_back(dependent);
+            }
+        }
+    }
+
+    for (CraftNode* node : affected) {
+        node->affected_ = false;
+    }
+}
+
+/*
+    @pre index_mutex_ is held
+    @return The pantry ingredients whose recipe lists ingredient
+*/
+std::vector<Ingredient*> Pantry::dependentsOf(const Ingredient* ingredient) const {
+    std::vector<Ingredient*> dependents;
+    auto node = craft_.find(ingredient);
+    if (node != craft_.end()) {
+        for (const CraftNode* user : node->second.used_by_) {
+            dependents.push_back(user->ingredient_);
+        }
+    }
+    return dependents;
+}
+
+/*
+    @param The name of a catalog file, in the format Pantry(path) describes
+    @param How many threads to parse it with, 0 for one per core
+    @post Every ingredient in the file is added in file order. The file is mapped
+        into memory and split at line ends into one chunk per thread; each thread
+        parses its chunk in place and makes the ingredients for it. The chunks are
+        then merged in file order, so the result does not depend on threads.
+        Recipes may name ingredients defined further down, and are resolved once
+        the whole file has been read.
+    @throws std::runtime_error if the file cannot be read, or naming the line of the first malformed row
+*/
+void Pantry::loadCatalog(const std::string& path, unsigned threads) {
+    MappedFile file(path);
+    std::string_view text = file.contents();
+
+    // The first line is a header
+    nextLine(text);
+
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    size_t chunk_count = std::min<size_t>(threads, text.size() / MIN_CHUNK_BYTES + 1);
+
+    // Cut at the first line end past each even share, so every chunk holds whole lines
+    std::vector<CatalogChunk> chunks(chunk_count);
+    size_t start = 0;
+    for (size_t k = 0; k < chunk_count; k++) {
+        size_t end = text.size();
+        if (k + 1 < chunk_count) {
+            size_t line_end = text.find('\n', std::max(start, text.size() * (k + 1) / chunk_count));
+            end = (line_end == std::string_view::npos) ? text.size() : line_end + 1;
+        }
+        chunks[k].text_ = text.substr(start, end - start);
+        start = end;
+    }
+
+    std::vector<CatalogRow> rows;
+    std::vector<Ingredient*> ingredients;
+    try {
+        inParallel(chunks.size(), [&](size_t k) { parseCatalogChunk(chunks[k]); });
+
+        // Merge in file order. The first malformed row is reported, counting lines from the header's.
+        size_t line_number = 1;
+        for (const CatalogChunk& chunk : chunks) {
+            if (chunk.problem_) {
+                throw std::runtime_error(path + ":" + std::to_string(line_number + chunk.lines_) + ": " + chunk.problem_);
+            }
+            line_number += chunk.lines_;
+        }
+        for (CatalogChunk& chunk : chunks) {
+            rows.insert(rows.end(), chunk.rows_.begin(), chunk.rows_.end());
+            ingredients.insert(ingredients.end(), chunk.ingredients_.begin(), chunk.ingredients_.end());
+            chunk.ingredients_.clear();
+        }
+    } catch (...) {
+        for (CatalogChunk& chunk : chunks) {
+            for (Ingredient* i : chunk.ingredients_) {
+                delete i;
+            }
+        }
+        for (Ingredient* i : ingredients) {
+            delete i;
+        }
+        throw;
+    }
+
+    // Name -> id (row) of its first definition. A repeated name is dropped, as addIngredient would.
+    std::unordered_map<std::string_view, size_t> ids;
+    ids.reserve(rows.size());
+    for (size_t id = 0; id < rows.size(); id++) {
+        if (!ids.emplace(rows[id].name_, id).second) {
+            delete ingredients[id];
+            ingredients[id] = nullptr;
+        }
+    }
+
+    // Every name is known now, so forward references resolve like any other.
+    // Each thread fills in the recipes of its own share of the rows.
+    inParallel(chunk_count, [&](size_t k) {
+        for (size_t id = rows.size() * k / chunk_count; id < rows.size() * (k + 1) / chunk_count; id++) {
+            if (!ingredients[id]) {
+                continue;
+            }
+            std::string_view recipe = rows[id].recipe_;
+            if (!recipe.empty()) {
+                ingredients[id]->recipe_.reserve(std::count(recipe.begin(), recipe.end(), ' ') + 1);
+            }
+            while (!recipe.empty()) {
+                size_t space = recipe.find(' ');
+                auto found = ids.find(recipe.substr(0, space));
+                recipe.remove_prefix(space == std::string_view::npos ? recipe.size() : space + 1);
+
+                // SAFETY: Names that are defined nowhere are skipped
+                if (found != ids.end()) {
+                    ingredients[id]->recipe_.push_back(ingredients[found->second]);
+                }
+            }
+        }
+    });
+
+    ingredients.erase(std::remove(ingredients.begin(), ingredients.end(), nullptr), ingredients.end());
+    addIngredients(ingredients);
+}
+
+/**
+    @param: The name of the file to write
+    @post: The pantry is saved as a binary snapshot: a versioned, checksummed file holding a flat table of
+            ingredients, their recipes as 32-bit indices into that table, and one pool for every name and
+            description. Ingredients that recipes name but that are not in the pantry are saved too, so the
+            recipes come back whole.
+    @throws: std::runtime_error if the file cannot be written
+*/
+void Pantry::saveSnapshot(const std::string& path) const {
+    // Number the pantry in list order, then whatever the recipes reach outside it as it is found
+    std::vector<const Ingredient*> table;
+    std::unordered_map<const Ingredient*, uint32_t> ids;
+    for (Ingredient* i : *this) {
+        ids.emplace(i, static_cast<uint32_t>(table.size()));
+        table.push_back(i);
+    }
+    size_t in_pantry = table.size();
+
+    std::vector<SnapshotIngredient> records;
+    std::vector<uint32_t> edges;
+    std::string pool;
+    records.reserve(table.size());
+    for (size_t id = 0; id < table.size(); id++) {
+        const Ingredient* i = table[id];
+        SnapshotIngredient record;
+        record.name_offset_ = static_cast<uint32_t>(pool.size());
+        record.name_length_ = static_cast<uint32_t>(i->name_.size());
+        pool += i->name_;
+        record.description_offset_ = static_cast<uint32_t>(pool.size());
+        record.description_length_ = static_cast<uint32_t>(i->description_.size());
+        pool += i->description_;
+        record.quantity_ = i->quantity_;
+        record.price_ = i->price_;
+        record.recipe_begin_ = static_cast<uint32_t>(edges.size());
+        record.recipe_count_ = static_cast<uint32_t>(i->recipe_.size());
+        record.flags_ = (id < in_pantry) ? SNAPSHOT_IN_PANTRY : 0;
+        records.push_back(record);
+
+        for (const Ingredient* req_ingredient : i->recipe_) {
+            auto found = ids.emplace(req_ingredient, static_cast<uint32_t>(table.size()));
+            if (found.second) {
+                table.push_back(req_ingredient);
+            }
+            edges.push_back(found.first->second);
+        }
+    }
+
+    // Offsets and counts are 32-bit
+    if (table.size() > UINT32_MAX || edges.size() > UINT32_MAX || pool.size() > UINT32_MAX) {
+        throw std::runtime_error("Pantry is too large for a snapshot: " + path);
+    }
+    pool.resize((pool.size() + 3) / 4 * 4, '\0');
+
+    SnapshotHeader header;
+    std::memcpy(header.magic_, SNAPSHOT_MAGIC, sizeof(header.magic_));
+    header.version_ = SNAPSHOT_VERSION;
+    header.ingredient_count_ = static_cast<uint32_t>(records.size());
+    header.edge_count_ = static_cast<uint32_t>(edges.size());
+    header.pool_size_ = static_cast<uint32_t>(pool.size());
+
+    const char* record_bytes = reinterpret_cast<const char*>(records.data());
+    const char* edge_bytes = reinterpret_cast<const char*>(edges.data());
+    header.checksum_ = snapshotChecksum(record_bytes, records.size() * sizeof(SnapshotIngredient));
+    header.checksum_ = snapshotChecksum(edge_bytes, edges.size() * sizeof(uint32_t), header.checksum_);
+    header.checksum_ = snapshotChecksum(pool.data(), pool.size(), header.checksum_);
+
+    std::ofstream f { path, std::ios::binary | std::ios::trunc };
+    f.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    f.write(record_bytes, records.size() * sizeof(SnapshotIngredient));
+    f.write(edge_bytes, edges.size() * sizeof(uint32_t));
+    f.write(pool.data(), pool.size());
+    f.close();
+    if (!f) {
+        throw std::runtime_error("Failed to write file: " + path);
+    }
+}
+
+/**
+    @param: The name of a file written by saveSnapshot
+    @post: The snapshot's ingredients are added in the order they were saved, with nothing to parse: the file
+            is mapped into memory and the table read in place. An ingredient whose name is already in the
+            pantry is not added again, and recipes in the snapshot use the one already there.
+    @throws: std::runtime_error if the file cannot be read, is not a snapshot of this version, fails its checksum,
+            or holds an invalid record (out of bounds, negative, or a name twice in the pantry)
+*/
+void Pantry::loadSnapshot(const std::string& path) {
+    MappedFile file(path);
+    std::string_view data = file.contents();
+
+    SnapshotHeader header;
+    if (data.size() < sizeof(header)) {
+        throw std::runtime_error("Not a Pantry snapshot: " + path);
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (std::memcmp(header.magic_, SNAPSHOT_MAGIC, sizeof(header.magic_)) != 0) {
+        throw std::runtime_error("Not a Pantry snapshot: " + path);
+    }
+    if (header.version_ != SNAPSHOT_VERSION) {
+        throw std::runtime_error("Unsupported snapshot version " + std::to_string(header.version_) + ": " + path);
+    }
+
+    uint64_t table_size = uint64_t(header.ingredient_count_) * sizeof(SnapshotIngredient);
+    uint64_t edges_size = uint64_t(header.edge_count_) * sizeof(uint32_t);
+    if (data.size() != sizeof(header) + table_size + edges_size + header.pool_size_
+            || snapshotChecksum(data.data() + sizeof(header), data.size() - sizeof(header)) != header.checksum_) {
+        throw std::runtime_error("Corrupt snapshot: " + path);
+    }
+    const char* table = data.data() + sizeof(header);
+    const char* edges = table + table_size;
+    const char* pool = edges + edges_size;
+
+    // Check every record before anything is allocated. Names in the pantry must be distinct,
+    // or adding the second of two would fail after it was made
+    std::unordered_set<std::string_view> pantry_names;
+    pantry_names.reserve(header.ingredient_count_);
+    for (size_t id = 0; id < header.ingredient_count_; id++) {
+        SnapshotIngredient record = snapshotRecord(table, id);
+        bool valid = uint64_t(record.name_offset_) + record.name_length_ <= header.pool_size_
+                && uint64_t(record.description_offset_) + record.description_length_ <= header.pool_size_
+                && uint64_t(record.recipe_begin_) + record.recipe_count_ <= header.edge_count_
+                && record.quantity_ >= 0 && record.price_ >= 0;
+        if (valid && (record.flags_ & SNAPSHOT_IN_PANTRY)) {
+            valid = pantry_names.emplace(pool + record.name_offset_, record.name_length_).second;
+        }
+        for (uint32_t e = 0; valid && e < record.recipe_count_; e++) {
+            uint32_t req_id;
+            std::memcpy(&req_id, edges + (uint64_t(record.recipe_begin_) + e) * sizeof(uint32_t), sizeof(req_id));
+            valid = req_id < header.ingredient_count_;
+        }
+        if (!valid) {
+            throw std::runtime_error("Corrupt snapshot: " + path);
+        }
+    }
+
+    // Strings are copied straight out of the pool, and recipes sized up front
+    std::vector<Ingredient*> ingredients(header.ingredient_count_, nullptr);
+    std::vector<bool> made(header.ingredient_count_, false);
+    for (size_t id = 0; id < ingredients.size(); id++) {
+        SnapshotIngredient record = snapshotRecord(table, id);
+        std::string name(pool + record.name_offset_, record.name_length_);
+        if (record.flags_ & SNAPSHOT_IN_PANTRY) {
+            ingredients[id] = getIngredient(name);
+        }
+        if (!ingredients[id]) {
+            ingredients[id] = new Ingredient { std::move(name),
+                                               std::string(pool + record.description_offset_, record.description_length_),
+                                               record.quantity_, record.price_, {} };
+            made[id] = true;
+        }
+    }
+
+    for (size_t id = 0; id < ingredients.size(); id++) {
+        if (!made[id]) {
+            continue;
+        }
+        SnapshotIngredient record = snapshotRecord(table, id);
+        std::vector<Ingredient*>& recipe = ingredients[id]->recipe_;
+        recipe.reserve(record.recipe_count_);
+        for (uint32_t e = 0; e < record.recipe_count_; e++) {
+            uint32_t req_id;
+            std::memcpy(&req_id, edges + (uint64_t(record.recipe_begin_) + e) * sizeof(uint32_t), sizeof(req_id));
+            recipe.push_back(ingredients[req_id]);
+        }
+    }
+
+    std::vector<Ingredient*> added;
+    added.reserve(ingredients.size());
+    for (size_t id = 0; id < ingredients.size(); id++) {
+        if (made[id] && (snapshotRecord(table, id).flags_ & SNAPSHOT_IN_PANTRY)) {
+            added.push_back(ingredients[id]);
+        }
+    }
+    addIngredients(added);
+}
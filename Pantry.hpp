@@ -6,8 +6,14 @@
 #include <vector>
 #include <stdexcept>
 #include <iostream>
+#include <mutex>
+#include <unordered_map>
 
 #include "LinkedList.hpp"
+#include "NodePool.hpp"
+#include "UnrolledList.hpp"
+#include "SkipList.hpp"
+#include "ConcurrentList.hpp"
 
 struct Ingredient {
     std::string name_;
@@ -36,8 +42,146 @@ struct Ingredient {
         : name_(name), description_(description), quantity_(quantity), price_(price), recipe_(recipe) {}
 };
 
-class Pantry : public LinkedList<Ingredient*> {
+/*
+    List backing Pantry. Build with -DPANTRY_UNROLLED to store ingredients in chunks
+    (faster full scans), -DPANTRY_SKIPLIST for O(log n) positional edits, or
+    -DPANTRY_CONCURRENT for a lock-free list that several threads can iterate while
+    others add and remove ingredients (adds and removes take a lock on the name index,
+    and the Ingredients themselves are not guarded); by default
+    nodes come from a per-pantry pool, so loading appends them contiguously and removals
+    recycle them. The default list is doubly linked and defines PANTRY_HANDLES: its
+    handles stay valid across other edits and erase their item in O(1).
+*/
+#if defined(PANTRY_UNROLLED)
+typedef UnrolledList<Ingredient*> PantryList;
+#elif defined(PANTRY_SKIPLIST)
+typedef SkipList<Ingredient*> PantryList;
+#elif defined(PANTRY_CONCURRENT)
+typedef ConcurrentList<Ingredient*> PantryList;
+typedef std::mutex PantryIndexMutex;
+#else
+typedef LinkedList<Ingredient*, PoolAllocator<Ingredient*>, true> PantryList;
+#define PANTRY_HANDLES
+#endif
+
+#if !defined(PANTRY_CONCURRENT)
+// Lock for the name index that costs nothing when the Pantry has one user at a time
+struct PantryIndexMutex {
+    void lock() {}
+    void unlock() {}
+};
+#endif
+
+class Pantry : public PantryList {
     private:
+        // Where an ingredient is, by name
+        struct IndexEntry {
+            Ingredient* ingredient_;
+            int position_;              // only trusted while positions_stale_ is false
+#if defined(PANTRY_HANDLES)
+            PantryList::Handle handle_; // for O(1) removal
+#endif
+        };
+
+        // Name -> entry for every ingredient in the list, so name lookups skip the walk.
+        // Positions are refreshed in one pass the first time they are needed after a
+        // removal or a sort; appends keep them valid.
+        mutable std::unordered_map<std::string, IndexEntry> index_;
+        mutable bool positions_stale_;
+        mutable PantryIndexMutex index_mutex_;
+
+        // Craftability bookkeeping for an ingredient that is in the pantry, or that the
+        // recipe of one in the pantry names. Nodes link to each other directly, since
+        // unordered_map never moves them.
+        struct CraftNode {
+            Ingredient* ingredient_ = nullptr;  // the ingredient this node tracks
+            std::vector<CraftNode*> used_by_;   // nodes of pantry ingredients whose recipe lists this one, once per listing
+            bool member_ = false;               // this Ingredient object is in the pantry
+            bool craftable_ = false;            // what canCreate answers, kept up to date while member_
+            bool affected_ = false;             // scratch for updateCraftable, false between calls
+            int waiting_ = 0;                   // scratch for updateCraftable
+        };
+
+        // Kept up to date by every add, remove and setQuantity, so craftability checks are
+        // lookups. Guarded by index_mutex_.
+        std::unordered_map<const Ingredient*, CraftNode> craft_;
+
+        /*
+            @pre index_mutex_ is held and ingredient has just been added to the list
+            @post ingredient is a member, and listed in used_by_ of each of its recipe ingredients
+        */
+        void linkCraftNode(Ingredient* ingredient);
+
+        /*
+            @pre index_mutex_ is held and ingredient has just been removed from the list
+            @post ingredient is no longer a member, nor listed in any used_by_
+        */
+        void unlinkCraftNode(Ingredient* ingredient);
+
+        /*
+            @pre index_mutex_ is held
+            @param Pantry ingredients whose recipe inputs changed
+            @post craftable_ is correct again for seeds and for everything that depends on them
+                through ingredients you have none of. Nothing else is visited, so the cost is
+                O(affected subgraph). Ingredients that need themselves cannot be created.
+        */
+        void updateCraftable(const std::vector<Ingredient*>& seeds);
+
+        /*
+            @pre index_mutex_ is held
+            @return The pantry ingredients whose recipe lists ingredient
+        */
+        std::vector<Ingredient*> dependentsOf(const Ingredient* ingredient) const;
+
+        /*
+            @param The name of a catalog file, in the format Pantry(path) describes
+            @param How many threads to parse it with, 0 for one per core
+            @post Every ingredient in the file is added in file order. The file is mapped
+                into memory and split at line ends into one chunk per thread; each thread
+                parses its chunk in place and makes the ingredients for it. The chunks are
+                then merged in file order, so the result does not depend on threads.
+                Recipes may name ingredients defined further down, and are resolved once
+                the whole file has been read.
+            @throws std::runtime_error if the file cannot be read, or naming the line of the first malformed row
+        */
+        void loadCatalog(const std::string& path, unsigned threads);
+
+        /*
+            @pre index_mutex_ is held
+            @post Every entry's position_ matches the list again and positions_stale_ is false
+        */
+        void refreshPositions() const;
+
+        /*
+            @post index_ holds an entry for every ingredient in the list (and nothing else)
+        */
+        void rebuildIndex();
+
+        /*
+            @param Ingredients to append, in order
+            @post Each one is appended and indexed as addIngredient would, under one lock, and
+                craftability is then worked out once for all of them, as rebuildIndex does.
+                An ingredient whose name is already in the pantry is skipped and stays the caller's.
+        */
+        void addIngredients(const std::vector<Ingredient*>& ingredients);
+
+        // Edits go through the Pantry's own methods, so the index stays in sync
+        using PantryList::insert;
+        using PantryList::emplace;
+        using PantryList::push_back;
+        using PantryList::push_front;
+        using PantryList::remove;
+        using PantryList::clear;
+        using PantryList::sort;
+#if defined(PANTRY_HANDLES)
+        using PantryList::insertAfter;
+        using PantryList::emplaceAfter;
+        using PantryList::erase;
+        using PantryList::splice;
+        using PantryList::merge;
+        using PantryList::handleAt;
+#endif
+
         /*
             @param A pointer to the ingredient
             @post Will output in the format of 
@@ -54,6 +198,13 @@ class Pantry : public LinkedList<Ingredient*> {
         */
         Pantry();
 
+        /**
+           Copy Constructor
+           @post: Holds the same Ingredient pointers in the same order as other
+        */
+        Pantry(const Pantry& other);
+        Pantry& operator=(const Pantry& other) = delete;
+
         /**
             @param: the name of an input file
             @pre: Formatting of the csv file is as follows:
@@ -84,10 +235,18 @@ class Pantry : public LinkedList<Ingredient*> {
                 Hint: update as needed using addIngredient()
 
             @post: Each line of the input file corresponds to a ingredient to be added to the list. No duplicates are allowed.
-            Hint: use std::ifstream and getline()
+                    A recipe may name an ingredient defined later in the file; names defined nowhere are left out of the recipe.
+            @throws: std::runtime_error if the file cannot be opened, or "[path]:[line]: [problem]" for a malformed row
         */
         Pantry(const std::string& path);
 
+        /**
+            @param: the name of an input file, in the format Pantry(path) describes
+            @param: how many threads to parse it with, 0 for one per core
+            @post: The same ingredients, in the same order, as Pantry(path)
+        */
+        Pantry(const std::string& path, unsigned threads);
+
          /**
                 Destructor
                 @post: Explicitly deletes every dynamically allocated Ingredient object
@@ -126,15 +285,49 @@ class Pantry : public LinkedList<Ingredient*> {
         */
         bool addIngredient(const std::string& name, const std::string& description, const int& quantity, const int& price, const std::vector<Ingredient*>& recipe);
 
+        /**
+            @param: A const string reference to a ingredient name
+            @post: The ingredient is no longer in the Pantry. It is not deleted, since other ingredients' recipes may still point to it.
+            @return: A pointer to the removed Ingredient, which the caller now owns. nullptr if it was not in the Pantry.
+        */
+        Ingredient* removeIngredient(const std::string& name);
+
+        /**
+            @param: A const string reference to a ingredient name
+            @param: The new quantity, a non negative integer
+            @post: The ingredient's quantity is set. When it goes from 0 to some or back, only the
+                    ingredients whose recipes depend on it have their craftability worked out again.
+                    Quantities of ingredients in the pantry must be changed through here (and recipes
+                    not at all) for canCreate to stay correct.
+            @return: True if the quantity was set, false if the ingredient is not in the Pantry or quantity is negative
+        */
+        bool setQuantity(const std::string& name, int quantity);
+
         /*
             @param A const string reference reresenting an ingredient name
             @return A pointer to the Ingredient if the ingredient is in the pantry. nullptr if not
         */
         Ingredient* getIngredient(const std::string& name) const;
 
+        /*
+            @return Iterators over the ingredients, in list order. Only const iterators are
+                handed out, so the list can only change through the Pantry's own methods.
+        */
+        PantryList::const_iterator begin() const;
+        PantryList::const_iterator end() const;
+
+        /*
+            @param A position in the list, indexing from 0
+            @return A pointer to the Ingredient pointer at position, which cannot be reassigned through it. nullptr if position is not valid
+        */
+        Ingredient* const* tryGetEntry(int position) const;
+
         /**
             @param:  A Ingredient pointer
             @return: A boolean indicating if all the given ingredient can be created (all of the ingredients in its recipe can be created, or if you have enough of each ingredient in its recipe to create it)
+            @note: O(1) for an ingredient in the pantry, read from the craftability that updateCraftable keeps up to date.
+                    Its counting pass is what makes recipes that need themselves uncraftable instead of endless.
+                    Other ingredients take one pass over their recipe.
         */
         bool canCreate(Ingredient* ingredient) const;
 
@@ -224,4 +417,31 @@ class Pantry : public LinkedList<Ingredient*> {
         */
         void pantryList(const std::string& filter = "NONE") const;
 
+        /**
+            @param: A const string reference to a sort order, "NAME" or "PRICE"
+            @post: The ingredients are reordered in place by name, or by ascending price.
+                Ingredients that compare equal keep their current order, and later pantryList calls print in the new order.
+            @return: True if the pantry was sorted, false if the order is invalid (the pantry is left unchanged)
+        */
+        bool sortIngredients(const std::string& order);
+
+        /**
+            @param: The name of the file to write
+            @post: The pantry is saved as a binary snapshot: a versioned, checksummed file holding a flat table of
+                    ingredients, their recipes as 32-bit indices into that table, and one pool for every name and
+                    description. Ingredients that recipes name but that are not in the pantry are saved too, so the
+                    recipes come back whole.
+            @throws: std::runtime_error if the file cannot be written
+        */
+        void saveSnapshot(const std::string& path) const;
+
+        /**
+            @param: The name of a file written by saveSnapshot
+            @post: The snapshot's ingredients are added in the order they were saved, with nothing to parse: the file
+                    is mapped into memory and the table read in place. An ingredient whose name is already in the
+                    pantry is not added again, and recipes in the snapshot use the one already there.
+            @throws: std::runtime_error if the file cannot be read, is not a snapshot of this version, or fails its checksum
+        */
+        void loadSnapshot(const std::string& path);
+
 };
@@ -0,0 +1,567 @@
+/** Indexable skip list.
+
+ Implementation file for the class SkipList.
+ @file SkipList.cpp */
+
+#include "SkipList.hpp"  // Header file
+#include <new>
+#include <string>
+#include <utility>
+
+// constructor
+template<class T>
+SkipList<T>::SkipList() : level_(1), item_count_(0), random_state_(2463534242u)
+{
+   for (int i = 0; i < MAX_LEVEL; i++)
+      head_[i] = Link{nullptr, 0};
+}  // end default constructor
+
+
+// copy constructor
+template<class T>
+SkipList<T>::SkipList(const SkipList<T>& a_list) : SkipList()
+{
+   for (const T& item : a_list)
+      push_back(item);
+}  // end copy constructor
+
+
+// destructor
+template<class T>
+SkipList<T>::~SkipList()
+{
+   clear();
+}  // end destructor
+
+
+
+/**@return true if list is empty - item_count_ == 0 */
+template<class T>
+bool SkipList<T>::isEmpty() const
+{
+   return item_count_ == 0;
+}  // end isEmpty
+
+
+/**@return the number of items in the list - item_count_ */
+template<class T>
+int SkipList<T>::getLength() const
+{
+   return item_count_;
+}  // end getLength
+
+
+
+/**
+ @pre list positions follow traditional indexing from 0 to item_count_ -1
+ @param position indicating point of insertion
+ @param new_entry to be inserted in list
+ @post new_entry is added at position in list (the item previously at that position is now at position+1)
+ @return true if valid position (0 <= position <= item_count_) */
+template<class T>
+bool SkipList<T>::insert(int position, const T& new_entry)
+{
+   return emplace(position, new_entry);
+}  // end insert
+
+template<class T>
+bool SkipList<T>::insert(int position, T&& new_entry)
+{
+   return emplace(position, std::move(new_entry));
+}  // end insert
+
+
+
+/**
+ @pre list positions follow traditional indexing from 0 to item_count_ -1
+ @param position indicating point of insertion
+ @param args arguments for T's constructor
+ @post an item built in place from args is added at position in list, in expected O(log n)
+ @return true if valid position (0 <= position <= item_count_) */
+template<class T>
+template<class... Args>
+bool SkipList<T>::emplace(int position, Args&&... args)
+{
+   bool able_to_insert = (position >= 0) && (position <= item_count_);
+   if (able_to_insert)
+   {
+      int height = randomHeight();
+      SkipNode* new_node_ptr = createNode(height, std::forward<Args>(args)...);
+
+      // New levels start out as empty links from the head
+      for (; level_ < height; level_++)
+         head_[level_] = Link{nullptr, 0};
+
+      Link* update[MAX_LEVEL];
+      int update_pos[MAX_LEVEL];
+      findPredecessors(position, update, update_pos);
+
+      for (int i = 0; i < level_; i++)
+      {
+         Link& prev = update[i][i];
+         if (i < height)
+         {
+            // Splice in: prev now reaches the new node, which takes over the rest of prev's span
+            int distance = position - update_pos[i];
+            new_node_ptr->links_[i].next_ = prev.next_;
+            new_node_ptr->links_[i].width_ = (prev.next_ != nullptr) ? prev.width_ - distance + 1 : 0;
+            prev.next_ = new_node_ptr;
+            prev.width_ = distance;
+         }
+         else if (prev.next_ != nullptr)
+         {
+            // The link passes over the new node
+            prev.width_++;
+         }  // end if
+      }  // end for
+
+      item_count_++;  // Increase count of entries
+   }  // end if
+
+   return able_to_insert;
+}  // end emplace
+
+
+
+/**
+ @param new_entry to be inserted in list
+ @post new_entry is added at the end of the list */
+template<class T>
+void SkipList<T>::push_back(const T& new_entry)
+{
+   insert(item_count_, new_entry);
+}  // end push_back
+
+template<class T>
+void SkipList<T>::push_back(T&& new_entry)
+{
+   insert(item_count_, std::move(new_entry));
+}  // end push_back
+
+
+
+/**
+ @param new_entry to be inserted in list
+ @post new_entry is added at the beginning of the list */
+template<class T>
+void SkipList<T>::push_front(const T& new_entry)
+{
+   insert(0, new_entry);
+}  // end push_front
+
+template<class T>
+void SkipList<T>::push_front(T&& new_entry)
+{
+   insert(0, std::move(new_entry));
+}  // end push_front
+
+
+
+/**
+ @pre list positions follow traditional indexing from 0 to item_count_ -1
+ @param position indicating point of deletion
+ @post item at position is deleted, if any, in expected O(log n). List order is retained
+ @return true if there is an item at position to be deleted, false otherwise */
+template<class T>
+bool SkipList<T>::remove(int position)
+{
+   bool able_to_remove = (position >= 0) && (position < item_count_);
+   if (able_to_remove)
+   {
+      Link* update[MAX_LEVEL];
+      int update_pos[MAX_LEVEL];
+      findPredecessors(position, update, update_pos);
+      SkipNode* cur_ptr = update[0][0].next_;
+
+      for (int i = 0; i < level_; i++)
+      {
+         Link& prev = update[i][i];
+         if (prev.next_ == cur_ptr)
+         {
+            // Unlink: prev now spans both its own link and the removed node's
+            Link& skipped = cur_ptr->links_[i];
+            prev.width_ = (skipped.next_ != nullptr) ? prev.width_ + skipped.width_ - 1 : 0;
+            prev.next_ = skipped.next_;
+         }
+         else if (prev.next_ != nullptr)
+         {
+            // The link passed over the removed node
+            prev.width_--;
+         }  // end if
+      }  // end for
+
+      // Drop levels left empty
+      while (level_ > 1 && head_[level_ - 1].next_ == nullptr)
+         level_--;
+
+      destroyNode(cur_ptr);
+      item_count_--;  // Decrease count of entries
+   }  // end if
+
+   return able_to_remove;
+}  // end remove
+
+
+
+/**@post the list is empty and item_count_ == 0*/
+template<class T>
+void SkipList<T>::clear()
+{
+   SkipNode* cur_ptr = head_[0].next_;
+   while (cur_ptr != nullptr)
+   {
+      SkipNode* next_ptr = cur_ptr->links_[0].next_;
+      destroyNode(cur_ptr);
+      cur_ptr = next_ptr;
+   }  // end while
+
+   for (int i = 0; i < MAX_LEVEL; i++)
+      head_[i] = Link{nullptr, 0};
+   level_ = 1;
+   item_count_ = 0;
+}  // end clear
+
+
+
+/**
+ @param comp strict weak ordering on items
+ @post the items are in stable sorted order, relinking the existing nodes */
+template<class T>
+template<class Compare>
+void SkipList<T>::sort(Compare comp)
+{
+   SkipNode* tail_ptr;
+   head_[0].next_ = sortChain(head_[0].next_,
+                              [](SkipNode* node_ptr) { return node_ptr->links_[0].next_; },
+                              [](SkipNode* node_ptr, SkipNode* next_ptr) { node_ptr->links_[0].next_ = next_ptr; },
+                              [&comp](SkipNode* lhs, SkipNode* rhs) { return comp(lhs->item_, rhs->item_); },
+                              tail_ptr);
+   rebuildLevels();
+}  // end sort
+
+
+
+/**
+ @pre list positions follow traditional indexing from 0 to item_count_ -1
+ @param position indicating the position of the data to be retrieved
+ @return data item found at position. If position is not a valid position < item_count_
+ throws  PrecondViolatedExcep */
+template<class T>
+T SkipList<T>::getEntry(int position) const
+{
+   // Enforce precondition
+   bool able_to_get = (position >= 0) && (position < item_count_);
+   if (able_to_get)
+   {
+      return getNodeAt(position)->item_;
+   }
+   else
+   {
+      std::string message = "getEntry() called with an empty list or ";
+      message  = message + "invalid position.";
+      throw(PrecondViolatedExcep(message));
+   }  // end if
+}  // end getEntry
+
+
+
+/**
+ @param position indicating the position of the data to be retrieved
+ @return a pointer to the item at position, or nullptr if position is not a valid
+ position < item_count_. Never throws. */
+template<class T>
+T* SkipList<T>::tryGetEntry(int position)
+{
+   SkipNode* node_ptr = getNodeAt(position);
+   return (node_ptr == nullptr) ? nullptr : &node_ptr->item_;
+}  // end tryGetEntry
+
+template<class T>
+const T* SkipList<T>::tryGetEntry(int position) const
+{
+   SkipNode* node_ptr = getNodeAt(position);
+   return (node_ptr == nullptr) ? nullptr : &node_ptr->item_;
+}  // end tryGetEntry
+
+
+/**@return iterator to the first item */
+template<class T>
+typename SkipList<T>::iterator SkipList<T>::begin()
+{
+   return iterator(head_[0].next_);
+}  // end begin
+
+template<class T>
+typename SkipList<T>::const_iterator SkipList<T>::begin() const
+{
+   return const_iterator(head_[0].next_);
+}  // end begin
+
+
+/**@return iterator past the last item */
+template<class T>
+typename SkipList<T>::iterator SkipList<T>::end()
+{
+   return iterator(nullptr);
+}  // end end
+
+template<class T>
+typename SkipList<T>::const_iterator SkipList<T>::end() const
+{
+   return const_iterator(nullptr);
+}  // end end
+
+
+
+/************* PROTECTED METHODS ************/
+
+
+// @return  the node at position, or nullptr if position is not < item_count_
+template<class T>
+typename SkipList<T>::SkipNode* SkipList<T>::getNodeAt(int position) const
+{
+   if (position < 0 || position >= item_count_)
+      return nullptr;
+
+   // Take the widest link that does not overshoot, level by level
+   const Link* links = head_;
+   SkipNode* cur_ptr = nullptr;
+   int cur_pos = -1;
+   for (int i = level_ - 1; i >= 0; i--)
+   {
+      while (links[i].next_ != nullptr && cur_pos + links[i].width_ <= position)
+      {
+         cur_pos += links[i].width_;
+         cur_ptr = links[i].next_;
+         links = cur_ptr->links_;
+      }  // end while
+   }  // end for
+
+   return cur_ptr;
+}  // end getNodeAt
+
+
+// Finds, on every level in use, the last link array before position.
+// @param update set to the links of the rightmost node (or head) before position on each level
+// @param update_pos set to the positions of those nodes (-1 for the head)
+template<class T>
+void SkipList<T>::findPredecessors(int position, Link* update[], int update_pos[])
+{
+   Link* links = head_;
+   int cur_pos = -1;
+   for (int i = level_ - 1; i >= 0; i--)
+   {
+      while (links[i].next_ != nullptr && cur_pos + links[i].width_ < position)
+      {
+         cur_pos += links[i].width_;
+         links = links[i].next_->links_;
+      }  // end while
+      update[i] = links;
+      update_pos[i] = cur_pos;
+   }  // end for
+}  // end findPredecessors
+
+
+// @post the upper levels and every width are rebuilt from the order of level 0
+template<class T>
+void SkipList<T>::rebuildLevels()
+{
+   // Each node keeps its height; link it after the last node seen that reaches each level
+   Link* last[MAX_LEVEL];
+   int last_pos[MAX_LEVEL];
+   for (int i = 0; i < MAX_LEVEL; i++)
+   {
+      last[i] = head_;
+      last_pos[i] = -1;
+   }  // end for
+
+   int position = 0;
+   for (SkipNode* cur_ptr = head_[0].next_; cur_ptr != nullptr; cur_ptr = cur_ptr->links_[0].next_)
+   {
+      for (int i = 0; i < cur_ptr->height_; i++)
+      {
+         last[i][i].next_ = cur_ptr;
+         last[i][i].width_ = position - last_pos[i];
+         last[i] = cur_ptr->links_;
+         last_pos[i] = position;
+      }  // end for
+      position++;
+   }  // end for
+
+   for (int i = 0; i < MAX_LEVEL; i++)
+   {
+      last[i][i].next_ = nullptr;
+      last[i][i].width_ = 0;
+   }  // end for
+}  // end rebuildLevels
+
+
+// @return  a random node height in [1, MAX_LEVEL]
+template<class T>
+int SkipList<T>::randomHeight()
+{
+   // xorshift32; each pair of trailing zero bits adds a level, so p = 1/4
+   random_state_ ^= random_state_ << 13;
+   random_state_ ^= random_state_ >> 17;
+   random_state_ ^= random_state_ << 5;
+   int height = 1 + __builtin_ctz(random_state_ | (1u << 31)) / 2;
+   return (height < MAX_LEVEL) ? height : MAX_LEVEL;
+}  // end randomHeight
+
+
+// @return  a new node of the given height whose item is built from args
+template<class T>
+template<class... Args>
+typename SkipList<T>::SkipNode* SkipList<T>::createNode(int height, Args&&... args)
+{
+   static_assert(alignof(SkipNode) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "over-aligned items are not supported");
+
+   void* block = ::operator new(sizeof(SkipNode) + height * sizeof(Link));
+   try
+   {
+      return ::new (block) SkipNode(height, std::forward<Args>(args)...);
+   }
+   catch (...)
+   {
+      ::operator delete(block);
+      throw;
+   }  // end try
+}  // end createNode
+
+
+// @post node_ptr is destroyed and its memory released
+template<class T>
+void SkipList<T>::destroyNode(SkipNode* node_ptr)
+{
+   node_ptr->~SkipNode();
+   ::operator delete(static_cast<void*>(node_ptr));
+}  // end destroyNode
+
+
+
+/************* NODE ************/
+
+
+template<class T>
+template<class... Args>
+SkipList<T>::SkipNode::SkipNode(int height, Args&&... args)
+   : links_(reinterpret_cast<Link*>(reinterpret_cast<unsigned char*>(this) + sizeof(SkipNode))),
+     height_(height), item_(std::forward<Args>(args)...)
+{
+}  // end constructor
+
+
+
+/************* ITERATOR ************/
+
+
+template<class T>
+SkipList<T>::const_iterator::const_iterator(SkipNode* node_ptr) : node_ptr_(node_ptr)
+{
+}  // end constructor
+
+
+template<class T>
+const T& SkipList<T>::const_iterator::operator*() const
+{
+   return node_ptr_->item_;
+}  // end operator*
+
+
+template<class T>
+const T* SkipList<T>::const_iterator::operator->() const
+{
+   return &node_ptr_->item_;
+}  // end operator->
+
+
+template<class T>
+typename SkipList<T>::const_iterator& SkipList<T>::const_iterator::operator++()
+{
+   node_ptr_ = node_ptr_->links_[0].next_;
+   return *this;
+}  // end operator++
+
+
+template<class T>
+typename SkipList<T>::const_iterator SkipList<T>::const_iterator::operator++(int)
+{
+   const_iterator before = *this;
+   node_ptr_ = node_ptr_->links_[0].next_;
+   return before;
+}  // end operator++
+
+
+template<class T>
+bool SkipList<T>::const_iterator::operator==(const const_iterator& rhs) const
+{
+   return node_ptr_ == rhs.node_ptr_;
+}  // end operator==
+
+
+template<class T>
+bool SkipList<T>::const_iterator::operator!=(const const_iterator& rhs) const
+{
+   return node_ptr_ != rhs.node_ptr_;
+}  // end operator!=
+
+
+template<class T>
+SkipList<T>::iterator::iterator(SkipNode* node_ptr) : node_ptr_(node_ptr)
+{
+}  // end constructor
+
+
+template<class T>
+SkipList<T>::iterator::operator const_iterator() const
+{
+   return const_iterator(node_ptr_);
+}  // end operator const_iterator
+
+
+template<class T>
+T& SkipList<T>::iterator::operator*() const
+{
+   return node_ptr_->item_;
+}  // end operator*
+
+
+template<class T>
+T* SkipList<T>::iterator::operator->() const
+{
+   return &node_ptr_->item_;
+}  // end operator->
+
+
+template<class T>
+typename SkipList<T>::iterator& SkipList<T>::iterator::operator++()
+{
+   node_ptr_ = node_ptr_->links_[0].next_;
+   return *this;
+}  // end operator++
+
+
+template<class T>
+typename SkipList<T>::iterator SkipList<T>::iterator::operator++(int)
+{
+   iterator before = *this;
+   node_ptr_ = node_ptr_->links_[0].next_;
+   return before;
+}  // end operator++
+
+
+template<class T>
+bool SkipList<T>::iterator::operator==(const iterator& rhs) const
+{
+   return node_ptr_ == rhs.node_ptr_;
+}  // end operator==
+
+
+template<class T>
+bool SkipList<T>::iterator::operator!=(const iterator& rhs) const
+{
+   return node_ptr_ != rhs.node_ptr_;
+}  // end operator!=
+
+
+//  End of implementation file.
@@ -0,0 +1,202 @@
+/*
+Indexable skip list: same positional interface as LinkedList, but every link also records
+how many positions it skips, so insert, remove and getEntry at any position descend the
+levels in expected O(log n) instead of walking from the head.
+*/
+
+#ifndef SKIP_LIST_
+#define SKIP_LIST_
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include "ChainSort.hpp"
+#include "PrecondViolatedExcep.hpp"
+
+/**
+    Node heights are drawn with probability 1/4 per extra level, so a node carries
+    1.33 links on average. Level 0 links every node in order and is what iterators follow.
+**/
+template<class T>
+class SkipList
+{
+   static constexpr int MAX_LEVEL = 16;  // enough for 4^16 items at p = 1/4
+
+   struct SkipNode;
+
+   // One forward link: the next node on this level and how many positions it advances
+   struct Link
+   {
+      SkipNode* next_;
+      int width_;  // only meaningful while next_ != nullptr
+   };
+
+   // Item plus height links, allocated in one block with the links right after the node
+   struct SkipNode
+   {
+      Link* links_;
+      int height_;
+      T item_;
+
+      template<class... Args>
+      SkipNode(int height, Args&&... args);
+   }; // end SkipNode
+
+public:
+   // Forward iterator over the items, in list order
+   class const_iterator
+   {
+   public:
+      typedef std::forward_iterator_tag iterator_category;
+      typedef T value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const T* pointer;
+      typedef const T& reference;
+
+      explicit const_iterator(SkipNode* node_ptr = nullptr);
+
+      const T& operator*() const;
+      const T* operator->() const;
+      const_iterator& operator++();
+      const_iterator operator++(int);
+      bool operator==(const const_iterator& rhs) const;
+      bool operator!=(const const_iterator& rhs) const;
+
+   private:
+      SkipNode* node_ptr_; // Current node, nullptr past the end
+   }; // end const_iterator
+
+   // Forward iterator that can modify the items in place
+   class iterator
+   {
+   public:
+      typedef std::forward_iterator_tag iterator_category;
+      typedef T value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef T* pointer;
+      typedef T& reference;
+
+      explicit iterator(SkipNode* node_ptr = nullptr);
+      operator const_iterator() const;
+
+      T& operator*() const;
+      T* operator->() const;
+      iterator& operator++();
+      iterator operator++(int);
+      bool operator==(const iterator& rhs) const;
+      bool operator!=(const iterator& rhs) const;
+
+   private:
+      SkipNode* node_ptr_; // Current node, nullptr past the end
+   }; // end iterator
+
+   SkipList(); // constructor
+   SkipList(const SkipList<T>& a_list); // copy constructor
+   SkipList<T>& operator=(const SkipList<T>& a_list) = delete;
+   virtual ~SkipList(); // destructor
+
+   /**@return true if list is empty - item_count_ == 0 */
+   bool isEmpty() const;
+
+    /**@return the number of items in the list - item_count_ */
+   int getLength() const;
+
+    /**
+     @pre list positions follow traditional indexing from 0 to item_count_ -1
+     @param position indicating point of insertion
+     @param new_entry to be inserted in list
+     @post new_entry is added at position in list (the item previously at that position is now at position+1)
+     @return true if valid position (0 <= position <= item_count_) */
+   bool insert(int position, const T& new_entry);
+   bool insert(int position, T&& new_entry);
+
+    /**
+     @pre list positions follow traditional indexing from 0 to item_count_ -1
+     @param position indicating point of insertion
+     @param args arguments for T's constructor
+     @post an item built in place from args is added at position in list, in expected O(log n)
+     @return true if valid position (0 <= position <= item_count_) */
+   template<class... Args>
+   bool emplace(int position, Args&&... args);
+
+    /**
+     @param new_entry to be inserted in list
+     @post new_entry is added at the end of the list */
+   void push_back(const T& new_entry);
+   void push_back(T&& new_entry);
+
+    /**
+     @param new_entry to be inserted in list
+     @post new_entry is added at the beginning of the list */
+   void push_front(const T& new_entry);
+   void push_front(T&& new_entry);
+
+    /**
+     @pre list positions follow traditional indexing from 0 to item_count_ -1
+     @param position indicating point of deletion
+     @post item at position is deleted, if any, in expected O(log n). List order is retained
+     @return true if there is an item at position to be deleted, false otherwise */
+   bool remove(int position);
+
+   /**@post the list is empty and item_count_ == 0*/
+   void clear();
+
+    /**
+     @param comp strict weak ordering on items
+     @post the items are in stable sorted order. Merge-sorts level 0 by relinking nodes,
+           then rebuilds the upper levels in one pass: O(n log n), allocates nothing */
+   template<class Compare = std::less<T>>
+   void sort(Compare comp = Compare());
+
+    /**
+     @pre list positions follow traditional indexing from 0 to item_count_ -1
+     @param position indicating the position of the data to be retrieved
+     @return data item found at position. If position is not a valid position < item_count_
+            throws  PrecondViolatedExcep */
+   T getEntry(int position) const;
+
+    /**
+     @param position indicating the position of the data to be retrieved
+     @return a pointer to the item at position, or nullptr if position is not a valid
+            position < item_count_. Never throws. */
+   T* tryGetEntry(int position);
+   const T* tryGetEntry(int position) const;
+
+    /**@return iterator to the first item */
+   iterator begin();
+   const_iterator begin() const;
+
+    /**@return iterator past the last item */
+   iterator end();
+   const_iterator end() const;
+
+protected:
+    Link head_[MAX_LEVEL];    // Links out of the head, which sits at position -1
+    int level_;               // Number of levels in use, at least 1
+    int item_count_;          // Current count of list items
+    unsigned random_state_;   // xorshift state for node heights
+
+    // @return  the node at position, or nullptr if position is not < item_count_
+    SkipNode* getNodeAt(int position) const;
+
+    // Finds, on every level in use, the last link array before position.
+    // @param update set to the links of the rightmost node (or head) before position on each level
+    // @param update_pos set to the positions of those nodes (-1 for the head)
+    void findPredecessors(int position, Link* update[], int update_pos[]);
+
+    // @post the upper levels and every width are rebuilt from the order of level 0
+    void rebuildLevels();
+
+    // @return  a random node height in [1, MAX_LEVEL]
+    int randomHeight();
+
+    // @return  a new node of the given height whose item is built from args
+    template<class... Args>
+    SkipNode* createNode(int height, Args&&... args);
+
+    // @post node_ptr is destroyed and its memory released
+    void destroyNode(SkipNode* node_ptr);
+}; // end SkipList
+
+#include "SkipList.cpp"
+#endif
@@ -0,0 +1,622 @@
+/** Unrolled linked list.
+
+ Implementation file for the class UnrolledList.
+ @file UnrolledList.cpp */
+
+#include "UnrolledList.hpp"  // Header file
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+// constructor
+template<class T, int CHUNK_ITEMS>
+UnrolledList<T, CHUNK_ITEMS>::UnrolledList()
+   : head_ptr_(nullptr), tail_ptr_(nullptr), item_count_(0), cursor_ptr_(nullptr), cursor_start_(0)
+{
+}  // end default constructor
+
+
+// copy constructor
+template<class T, int CHUNK_ITEMS>
+UnrolledList<T, CHUNK_ITEMS>::UnrolledList(const UnrolledList<T, CHUNK_ITEMS>& a_list) : UnrolledList()
+{
+   // Appending keeps every chunk but the last full
+   for (const T& item : a_list)
+      push_back(item);
+}  // end copy constructor
+
+
+// destructor
+template<class T, int CHUNK_ITEMS>
+UnrolledList<T, CHUNK_ITEMS>::~UnrolledList()
+{
+   clear();
+}  // end destructor
+
+
+
+/**@return true if list is empty - item_count_ == 0 */
+template<class T, int CHUNK_ITEMS>
+bool UnrolledList<T, CHUNK_ITEMS>::isEmpty() const
+{
+   return item_count_ == 0;
+}  // end isEmpty
+
+
+/**@return the number of items in the list - item_count_ */
+template<class T, int CHUNK_ITEMS>
+int UnrolledList<T, CHUNK_ITEMS>::getLength() const
+{
+   return item_count_;
+}  // end getLength
+
+
+
+/**
+ @pre list positions follow traditional indexing from 0 to item_count_ -1
+ @param position indicating point of insertion
+ @param new_entry to be inserted in list
+ @post new_entry is added at position in list (the item previously at that position is now at position+1)
+ @return true if valid position (0 <= position <= item_count_) */
+template<class T, int CHUNK_ITEMS>
+bool UnrolledList<T, CHUNK_ITEMS>::insert(int position, const T& new_entry)
+{
+   return emplace(position, new_entry);
+}  // end insert
+
+template<class T, int CHUNK_ITEMS>
+bool UnrolledList<T, CHUNK_ITEMS>::insert(int position, T&& new_entry)
+{
+   return emplace(position, std::move(new_entry));
+}  // end insert
+
+
+
+/**
+ @pre list positions follow traditional indexing from 0 to item_count_ -1
+ @param position indicating point of insertion
+ @param args arguments for T's constructor
+ @post an item built in place from args is added at position in list
+ @return true if valid position (0 <= position <= item_count_) */
+template<class T, int CHUNK_ITEMS>
+template<class... Args>
+bool UnrolledList<T, CHUNK_ITEMS>::emplace(int position, Args&&... args)
+{
+   bool able_to_insert = (position >= 0) && (position <= item_count_);
+   if (able_to_insert)
+   {
+      if (position == item_count_)
+      {
+         // Append to the tail chunk, starting a new one rather than splitting a full tail
+         Chunk* chunk_ptr = tail_ptr_;
+         if (chunk_ptr == nullptr || chunk_ptr->count_ == CHUNK_ITEMS)
+            chunk_ptr = linkChunkAfter(tail_ptr_);
+
+         try
+         {
+            emplaceInChunk(chunk_ptr, chunk_ptr->count_, std::forward<Args>(args)...);
+         }
+         catch (...)
+         {
+            if (chunk_ptr->count_ == 0)
+               unlinkChunk(chunk_ptr);
+            throw;
+         }  // end try
+      }
+      else
+      {
+         int offset;
+         Chunk* chunk_ptr = findChunk(position, offset);
+
+         // Split a full chunk in half, then insert into whichever half holds position
+         if (chunk_ptr->count_ == CHUNK_ITEMS)
+         {
+            Chunk* upper_ptr = linkChunkAfter(chunk_ptr);
+            moveTail(chunk_ptr, CHUNK_ITEMS / 2, upper_ptr);
+            if (offset > chunk_ptr->count_)
+            {
+               offset -= chunk_ptr->count_;
+               chunk_ptr = upper_ptr;
+            }  // end if
+         }  // end if
+
+         emplaceInChunk(chunk_ptr, offset, std::forward<Args>(args)...);
+      }  // end if
+
+      item_count_++;  // Increase count of entries
+   }  // end if
+
+   return able_to_insert;
+}  // end emplace
+
+
+
+/**
+ @param new_entry to be inserted in list
+ @post new_entry is added at the end of the list in O(1) */
+template<class T, int CHUNK_ITEMS>
+void UnrolledList<T, CHUNK_ITEMS>::push_back(const T& new_entry)
+{
+   insert(item_count_, new_entry);
+}  // end push_back
+
+template<class T, int CHUNK_ITEMS>
+void UnrolledList<T, CHUNK_ITEMS>::push_back(T&& new_entry)
+{
+   insert(item_count_, std::move(new_entry));
+}  // end push_back
+
+
+
+/**
+ @param new_entry to be inserted in list
+ @post new_entry is added at the beginning of the list in O(CHUNK_ITEMS) */
+template<class T, int CHUNK_ITEMS>
+void UnrolledList<T, CHUNK_ITEMS>::push_front(const T& new_entry)
+{
+   insert(0, new_entry);
+}  // end push_front
+
+template<class T, int CHUNK_ITEMS>
+void UnrolledList<T, CHUNK_ITEMS>::push_front(T&& new_entry)
+{
+   insert(0, std::move(new_entry));
+}  // end push_front
+
+
+
+/**
+ @pre list positions follow traditional indexing from 0 to item_count_ -1
+ @param position indicating point of deletion
+ @post item at position is deleted, if any. List order is retained
+ @return true if there is an item at position to be deleted, false otherwise */
+template<class T, int CHUNK_ITEMS>
+bool UnrolledList<T, CHUNK_ITEMS>::remove(int position)
+{
+   bool able_to_remove = (position >= 0) && (position < item_count_);
+   if (able_to_remove)
+   {
+      int offset;
+      Chunk* chunk_ptr = findChunk(position, offset);
+
+      // Close the gap within the chunk
+      T* items = chunk_ptr->items();
+      std::move(items + offset + 1, items + chunk_ptr->count_, items + offset);
+      std::destroy_at(items + chunk_ptr->count_ - 1);
+      chunk_ptr->count_--;
+      item_count_--;  // Decrease count of entries
+
+      Chunk* next_ptr = chunk_ptr->next_;
+      if (chunk_ptr->count_ == 0)
+      {
+         unlinkChunk(chunk_ptr);
+      }
+      else if (chunk_ptr->count_ < CHUNK_ITEMS / 2 && next_ptr != nullptr
+               && chunk_ptr->count_ + next_ptr->count_ <= CHUNK_ITEMS)
+      {
+         // Absorb the next chunk so sparse chunks do not pile up
+         moveTail(next_ptr, 0, chunk_ptr);
+         unlinkChunk(next_ptr);
+      }  // end if
+   }  // end if
+
+   return able_to_remove;
+}  // end remove
+
+
+
+/**@post the list is empty and item_count_ == 0*/
+template<class T, int CHUNK_ITEMS>
+void UnrolledList<T, CHUNK_ITEMS>::clear()
+{
+   Chunk* chunk_ptr = head_ptr_;
+   while (chunk_ptr != nullptr)
+   {
+      Chunk* next_ptr = chunk_ptr->next_;
+      std::destroy(chunk_ptr->items(), chunk_ptr->items() + chunk_ptr->count_);
+      delete chunk_ptr;
+      chunk_ptr = next_ptr;
+   }  // end while
+
+   head_ptr_ = nullptr;
+   tail_ptr_ = nullptr;
+   item_count_ = 0;
+   cursor_ptr_ = nullptr;
+   cursor_start_ = 0;
+}  // end clear
+
+
+
+/**
+ @param comp strict weak ordering on items
+ @post the items are in stable sorted order */
+template<class T, int CHUNK_ITEMS>
+template<class Compare>
+void UnrolledList<T, CHUNK_ITEMS>::sort(Compare comp)
+{
+   std::vector<T> buffer;
+   buffer.reserve(item_count_);
+   for (T& item : *this)
+      buffer.push_back(std::move(item));
+
+   std::stable_sort(buffer.begin(), buffer.end(), comp);
+
+   // Same number of items, so they go back into the same slots
+   typename std::vector<T>::iterator source = buffer.begin();
+   for (T& item : *this)
+      item = std::move(*source++);
+}  // end sort
+
+
+
+/**
+ @pre list positions follow traditional indexing from 0 to item_count_ -1
+ @param position indicating the position of the data to be retrieved
+ @return data item found at position. If position is not a valid position < item_count_
+ throws  PrecondViolatedExcep */
+template<class T, int CHUNK_ITEMS>
+T UnrolledList<T, CHUNK_ITEMS>::getEntry(int position)
+{
+   if (position < 0 || position >= item_count_)
+      return std::as_const(*this).getEntry(position);  // throws for the bad position
+
+   int offset;
+   Chunk* chunk_ptr = findChunk(position, offset);
+   return chunk_ptr->items()[offset];
+}  // end getEntry
+
+template<class T, int CHUNK_ITEMS>
+T UnrolledList<T, CHUNK_ITEMS>::getEntry(int position) const
+{
+   // Enforce precondition
+   bool able_to_get = (position >= 0) && (position < item_count_);
+   if (able_to_get)
+   {
+      int offset;
+      Chunk* chunk_ptr = findChunk(position, offset);
+      return chunk_ptr->items()[offset];
+   }
+   else
+   {
+      std::string message = "getEntry() called with an empty list or ";
+      message  = message + "invalid position.";
+      throw(PrecondViolatedExcep(message));
+   }  // end if
+}  // end getEntry
+
+
+
+/**
+ @param position indicating the position of the data to be retrieved
+ @return a pointer to the item at position, or nullptr if position is not a valid
+ position < item_count_. Never throws. */
+template<class T, int CHUNK_ITEMS>
+T* UnrolledList<T, CHUNK_ITEMS>::tryGetEntry(int position)
+{
+   if (position < 0 || position >= item_count_)
+      return nullptr;
+
+   int offset;
+   Chunk* chunk_ptr = findChunk(position, offset);
+   return chunk_ptr->items() + offset;
+}  // end tryGetEntry
+
+template<class T, int CHUNK_ITEMS>
+const T* UnrolledList<T, CHUNK_ITEMS>::tryGetEntry(int position) const
+{
+   if (position < 0 || position >= item_count_)
+      return nullptr;
+
+   int offset;
+   Chunk* chunk_ptr = findChunk(position, offset);
+   return chunk_ptr->items() + offset;
+}  // end tryGetEntry
+
+
+/**@return iterator to the first item */
+template<class T, int CHUNK_ITEMS>
+typename UnrolledList<T, CHUNK_ITEMS>::iterator UnrolledList<T, CHUNK_ITEMS>::begin()
+{
+   return iterator(head_ptr_, 0);
+}  // end begin
+
+template<class T, int CHUNK_ITEMS>
+typename UnrolledList<T, CHUNK_ITEMS>::const_iterator UnrolledList<T, CHUNK_ITEMS>::begin() const
+{
+   return const_iterator(head_ptr_, 0);
+}  // end begin
+
+
+/**@return iterator past the last item */
+template<class T, int CHUNK_ITEMS>
+typename UnrolledList<T, CHUNK_ITEMS>::iterator UnrolledList<T, CHUNK_ITEMS>::end()
+{
+   return iterator(nullptr, 0);
+}  // end end
+
+template<class T, int CHUNK_ITEMS>
+typename UnrolledList<T, CHUNK_ITEMS>::const_iterator UnrolledList<T, CHUNK_ITEMS>::end() const
+{
+   return const_iterator(nullptr, 0);
+}  // end end
+
+
+
+/************* PROTECTED METHODS ************/
+
+
+// Locates the chunk holding a position.
+// @pre 0 <= position < item_count_
+// @param offset set to the index of position within the chunk
+// @return  the chunk holding position
+template<class T, int CHUNK_ITEMS>
+typename UnrolledList<T, CHUNK_ITEMS>::Chunk* UnrolledList<T, CHUNK_ITEMS>::findChunk(int position, int& offset) const
+{
+   // Start from the closest known chunk at or before position
+   Chunk* chunk_ptr = head_ptr_;
+   int start = 0;
+   int tail_start = item_count_ - tail_ptr_->count_;
+   if (position >= tail_start)
+   {
+      chunk_ptr = tail_ptr_;
+      start = tail_start;
+   }
+   else if (cursor_ptr_ != nullptr && cursor_start_ <= position)
+   {
+      chunk_ptr = cursor_ptr_;
+      start = cursor_start_;
+   }  // end if
+
+   while (position >= start + chunk_ptr->count_)
+   {
+      start += chunk_ptr->count_;
+      chunk_ptr = chunk_ptr->next_;
+   }  // end while
+
+   offset = position - start;
+   return chunk_ptr;
+}  // end findChunk
+
+template<class T, int CHUNK_ITEMS>
+typename UnrolledList<T, CHUNK_ITEMS>::Chunk* UnrolledList<T, CHUNK_ITEMS>::findChunk(int position, int& offset)
+{
+   Chunk* chunk_ptr = std::as_const(*this).findChunk(position, offset);
+   cursor_ptr_ = chunk_ptr;
+   cursor_start_ = position - offset;
+   return chunk_ptr;
+}  // end findChunk
+
+
+// @post a new, empty chunk is linked in after chunk (or as the only chunk if chunk is nullptr)
+// @return  the new chunk
+template<class T, int CHUNK_ITEMS>
+typename UnrolledList<T, CHUNK_ITEMS>::Chunk* UnrolledList<T, CHUNK_ITEMS>::linkChunkAfter(Chunk* chunk_ptr)
+{
+   Chunk* new_chunk_ptr = new Chunk();
+   new_chunk_ptr->prev_ = chunk_ptr;
+   if (chunk_ptr == nullptr)
+   {
+      head_ptr_ = new_chunk_ptr;
+      tail_ptr_ = new_chunk_ptr;
+   }
+   else
+   {
+      new_chunk_ptr->next_ = chunk_ptr->next_;
+      if (chunk_ptr->next_ != nullptr)
+         chunk_ptr->next_->prev_ = new_chunk_ptr;
+      else
+         tail_ptr_ = new_chunk_ptr;
+      chunk_ptr->next_ = new_chunk_ptr;
+   }  // end if
+   return new_chunk_ptr;
+}  // end linkChunkAfter
+
+
+// @post chunk, which holds no items, is unlinked and deleted
+template<class T, int CHUNK_ITEMS>
+void UnrolledList<T, CHUNK_ITEMS>::unlinkChunk(Chunk* chunk_ptr)
+{
+   if (chunk_ptr->prev_ != nullptr)
+      chunk_ptr->prev_->next_ = chunk_ptr->next_;
+   else
+      head_ptr_ = chunk_ptr->next_;
+
+   if (chunk_ptr->next_ != nullptr)
+      chunk_ptr->next_->prev_ = chunk_ptr->prev_;
+   else
+      tail_ptr_ = chunk_ptr->prev_;
+
+   if (cursor_ptr_ == chunk_ptr)
+   {
+      cursor_ptr_ = nullptr;
+      cursor_start_ = 0;
+   }  // end if
+   delete chunk_ptr;
+}  // end unlinkChunk
+
+
+// @post the items of chunk from index on are moved to the end of to, which has room for them
+template<class T, int CHUNK_ITEMS>
+void UnrolledList<T, CHUNK_ITEMS>::moveTail(Chunk* chunk_ptr, int index, Chunk* to_ptr)
+{
+   T* from = chunk_ptr->items();
+   T* to = to_ptr->items() + to_ptr->count_;
+   int moving = chunk_ptr->count_ - index;
+   std::uninitialized_move(from + index, from + chunk_ptr->count_, to);
+   std::destroy(from + index, from + chunk_ptr->count_);
+   chunk_ptr->count_ = index;
+   to_ptr->count_ += moving;
+}  // end moveTail
+
+
+// @post an item built from args is inserted at offset in chunk, which is not full
+template<class T, int CHUNK_ITEMS>
+template<class... Args>
+void UnrolledList<T, CHUNK_ITEMS>::emplaceInChunk(Chunk* chunk_ptr, int offset, Args&&... args)
+{
+   T* items = chunk_ptr->items();
+   int count = chunk_ptr->count_;
+   if (offset == count)
+   {
+      ::new (static_cast<void*>(items + count)) T(std::forward<Args>(args)...);
+   }
+   else
+   {
+      // Build first: args may refer to one of the items about to shift
+      T new_item(std::forward<Args>(args)...);
+      ::new (static_cast<void*>(items + count)) T(std::move(items[count - 1]));
+      std::move_backward(items + offset, items + count - 1, items + count);
+      items[offset] = std::move(new_item);
+   }  // end if
+   chunk_ptr->count_++;
+}  // end emplaceInChunk
+
+
+
+/************* CHUNK ************/
+
+
+template<class T, int CHUNK_ITEMS>
+UnrolledList<T, CHUNK_ITEMS>::Chunk::Chunk() : prev_(nullptr), next_(nullptr), count_(0)
+{
+}  // end constructor
+
+
+template<class T, int CHUNK_ITEMS>
+T* UnrolledList<T, CHUNK_ITEMS>::Chunk::items()
+{
+   return reinterpret_cast<T*>(slots_);
+}  // end items
+
+
+
+/************* ITERATOR ************/
+
+
+template<class T, int CHUNK_ITEMS>
+UnrolledList<T, CHUNK_ITEMS>::const_iterator::const_iterator(Chunk* chunk_ptr, int index)
+   : chunk_(chunk_ptr), index_(index)
+{
+}  // end constructor
+
+
+template<class T, int CHUNK_ITEMS>
+const T& UnrolledList<T, CHUNK_ITEMS>::const_iterator::operator*() const
+{
+   return chunk_->items()[index_];
+}  // end operator*
+
+
+template<class T, int CHUNK_ITEMS>
+const T* UnrolledList<T, CHUNK_ITEMS>::const_iterator::operator->() const
+{
+   return chunk_->items() + index_;
+}  // end operator->
+
+
+template<class T, int CHUNK_ITEMS>
+typename UnrolledList<T, CHUNK_ITEMS>::const_iterator& UnrolledList<T, CHUNK_ITEMS>::const_iterator::operator++()
+{
+   // Chunks are never empty, so stepping past the last item lands on the next chunk's first
+   index_++;
+   if (index_ == chunk_->count_)
+   {
+      chunk_ = chunk_->next_;
+      index_ = 0;
+   }  // end if
+   return *this;
+}  // end operator++
+
+
+template<class T, int CHUNK_ITEMS>
+typename UnrolledList<T, CHUNK_ITEMS>::const_iterator UnrolledList<T, CHUNK_ITEMS>::const_iterator::operator++(int)
+{
+   const_iterator before = *this;
+   ++(*this);
+   return before;
+}  // end operator++
+
+
+template<class T, int CHUNK_ITEMS>
+bool UnrolledList<T, CHUNK_ITEMS>::const_iterator::operator==(const const_iterator& rhs) const
+{
+   return chunk_ == rhs.chunk_ && index_ == rhs.index_;
+}  // end operator==
+
+
+template<class T, int CHUNK_ITEMS>
+bool UnrolledList<T, CHUNK_ITEMS>::const_iterator::operator!=(const const_iterator& rhs) const
+{
+   return !(*this == rhs);
+}  // end operator!=
+
+
+
+template<class T, int CHUNK_ITEMS>
+UnrolledList<T, CHUNK_ITEMS>::iterator::iterator(Chunk* chunk_ptr, int index)
+   : chunk_(chunk_ptr), index_(index)
+{
+}  // end constructor
+
+
+template<class T, int CHUNK_ITEMS>
+UnrolledList<T, CHUNK_ITEMS>::iterator::operator const_iterator() const
+{
+   return const_iterator(chunk_, index_);
+}  // end operator const_iterator
+
+
+template<class T, int CHUNK_ITEMS>
+T& UnrolledList<T, CHUNK_ITEMS>::iterator::operator*() const
+{
+   return chunk_->items()[index_];
+}  // end operator*
+
+
+template<class T, int CHUNK_ITEMS>
+T* UnrolledList<T, CHUNK_ITEMS>::iterator::operator->() const
+{
+   return chunk_->items() + index_;
+}  // end operator->
+
+
+template<class T, int CHUNK_ITEMS>
+typename UnrolledList<T, CHUNK_ITEMS>::iterator& UnrolledList<T, CHUNK_ITEMS>::iterator::operator++()
+{
+   index_++;
+   if (index_ == chunk_->count_)
+   {
+      chunk_ = chunk_->next_;
+      index_ = 0;
+   }  // end if
+   return *this;
+}  // end operator++
+
+
+template<class T, int CHUNK_ITEMS>
+typename UnrolledList<T, CHUNK_ITEMS>::iterator UnrolledList<T, CHUNK_ITEMS>::iterator::operator++(int)
+{
+   iterator before = *this;
+   ++(*this);
+   return before;
+}  // end operator++
+
+
+template<class T, int CHUNK_ITEMS>
+bool UnrolledList<T, CHUNK_ITEMS>::iterator::operator==(const iterator& rhs) const
+{
+   return chunk_ == rhs.chunk_ && index_ == rhs.index_;
+}  // end operator==
+
+
+template<class T, int CHUNK_ITEMS>
+bool UnrolledList<T, CHUNK_ITEMS>::iterator::operator!=(const iterator& rhs) const
+{
+   return !(*this == rhs);
+}  // end operator!=
+
+
+//  End of implementation file.
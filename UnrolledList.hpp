@@ -0,0 +1,205 @@
+/*
+Unrolled linked list: a chain of cache-line-aligned chunks, each holding up to CHUNK_ITEMS
+items in place. Same interface as LinkedList, but a full scan touches one chunk per
+CHUNK_ITEMS items instead of one heap node per item.
+*/
+
+#ifndef UNROLLED_LIST_
+#define UNROLLED_LIST_
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include "PrecondViolatedExcep.hpp"
+
+/**
+    Chunks default to four cache lines (256 bytes) including their links.
+    A full chunk splits in half on insert, except at the tail, where sequential
+    appends start a new chunk so the earlier ones stay full. A chunk that falls
+    under half full on remove absorbs its successor if they fit together.
+**/
+template<class T, int CHUNK_ITEMS = (sizeof(T) <= 56 ? (256 - 32) / sizeof(T) : 4)>
+class UnrolledList
+{
+   static_assert(CHUNK_ITEMS >= 2, "a chunk must hold at least two items to split");
+
+   struct alignas(64) Chunk
+   {
+      Chunk* prev_;
+      Chunk* next_;
+      int count_;  // items live in items()[0, count_); never 0 while linked
+      alignas(T) unsigned char slots_[CHUNK_ITEMS * sizeof(T)];
+
+      Chunk();
+      T* items();
+   }; // end Chunk
+
+public:
+   // Forward iterator over the items, in list order
+   class const_iterator
+   {
+   public:
+      typedef std::forward_iterator_tag iterator_category;
+      typedef T value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const T* pointer;
+      typedef const T& reference;
+
+      const_iterator(Chunk* chunk = nullptr, int index = 0);
+
+      const T& operator*() const;
+      const T* operator->() const;
+      const_iterator& operator++();
+      const_iterator operator++(int);
+      bool operator==(const const_iterator& rhs) const;
+      bool operator!=(const const_iterator& rhs) const;
+
+   private:
+      Chunk* chunk_; // Current chunk, nullptr past the end
+      int index_;    // Position within chunk_
+   }; // end const_iterator
+
+   // Forward iterator that can modify the items in place
+   class iterator
+   {
+   public:
+      typedef std::forward_iterator_tag iterator_category;
+      typedef T value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef T* pointer;
+      typedef T& reference;
+
+      iterator(Chunk* chunk = nullptr, int index = 0);
+      operator const_iterator() const;
+
+      T& operator*() const;
+      T* operator->() const;
+      iterator& operator++();
+      iterator operator++(int);
+      bool operator==(const iterator& rhs) const;
+      bool operator!=(const iterator& rhs) const;
+
+   private:
+      Chunk* chunk_; // Current chunk, nullptr past the end
+      int index_;    // Position within chunk_
+   }; // end iterator
+
+   UnrolledList(); // constructor
+   UnrolledList(const UnrolledList<T, CHUNK_ITEMS>& a_list); // copy constructor
+   UnrolledList<T, CHUNK_ITEMS>& operator=(const UnrolledList<T, CHUNK_ITEMS>& a_list) = delete;
+   virtual ~UnrolledList(); // destructor
+
+   /**@return true if list is empty - item_count_ == 0 */
+   bool isEmpty() const;
+
+    /**@return the number of items in the list - item_count_ */
+   int getLength() const;
+
+    /**
+     @pre list positions follow traditional indexing from 0 to item_count_ -1
+     @param position indicating point of insertion
+     @param new_entry to be inserted in list
+     @post new_entry is added at position in list (the item previously at that position is now at position+1)
+     @return true if valid position (0 <= position <= item_count_) */
+   bool insert(int position, const T& new_entry);
+   bool insert(int position, T&& new_entry);
+
+    /**
+     @pre list positions follow traditional indexing from 0 to item_count_ -1
+     @param position indicating point of insertion
+     @param args arguments for T's constructor
+     @post an item built in place from args is added at position in list
+     @return true if valid position (0 <= position <= item_count_) */
+   template<class... Args>
+   bool emplace(int position, Args&&... args);
+
+    /**
+     @param new_entry to be inserted in list
+     @post new_entry is added at the end of the list in O(1) */
+   void push_back(const T& new_entry);
+   void push_back(T&& new_entry);
+
+    /**
+     @param new_entry to be inserted in list
+     @post new_entry is added at the beginning of the list in O(CHUNK_ITEMS) */
+   void push_front(const T& new_entry);
+   void push_front(T&& new_entry);
+
+    /**
+     @pre list positions follow traditional indexing from 0 to item_count_ -1
+     @param position indicating point of deletion
+     @post item at position is deleted, if any. List order is retained
+     @return true if there is an item at position to be deleted, false otherwise */
+   bool remove(int position);
+
+   /**@post the list is empty and item_count_ == 0*/
+   void clear();
+
+    /**
+     @param comp strict weak ordering on items
+     @post the items are in stable sorted order in O(n log n); sorts through a
+           temporary buffer of the items, since chunks cannot be relinked item by item */
+   template<class Compare = std::less<T>>
+   void sort(Compare comp = Compare());
+
+    /**
+     @pre list positions follow traditional indexing from 0 to item_count_ -1
+     @param position indicating the position of the data to be retrieved
+     @return data item found at position. If position is not a valid position < item_count_
+            throws  PrecondViolatedExcep
+     The non-const overload moves the cursor, so index loops are amortized O(1);
+     the const one leaves it alone and is safe to call from several threads at once. */
+   T getEntry(int position);
+   T getEntry(int position) const;
+
+    /**
+     @param position indicating the position of the data to be retrieved
+     @return a pointer to the item at position, or nullptr if position is not a valid
+            position < item_count_. Never throws. */
+   T* tryGetEntry(int position);
+   const T* tryGetEntry(int position) const;
+
+    /**@return iterator to the first item */
+   iterator begin();
+   const_iterator begin() const;
+
+    /**@return iterator past the last item */
+   iterator end();
+   const_iterator end() const;
+
+protected:
+    Chunk* head_ptr_;  // First chunk in the chain, nullptr when empty
+    Chunk* tail_ptr_;  // Last chunk in the chain, nullptr when empty
+    int item_count_;   // Current count of list items
+
+    // Last chunk found by the non-const findChunk and the position of its first item, so
+    // nearby positional access resumes from there. cursor_ptr_ is nullptr when unset.
+    // Const lookups only read it, so concurrent const access never writes shared state.
+    Chunk* cursor_ptr_;
+    int cursor_start_;
+
+    // Locates the chunk holding a position.
+    // @pre 0 <= position < item_count_
+    // @param offset set to the index of position within the chunk
+    // @return  the chunk holding position
+    // @post the non-const overload leaves the cursor at that chunk; the const one leaves it unchanged
+    Chunk* findChunk(int position, int& offset);
+    Chunk* findChunk(int position, int& offset) const;
+
+    // @post a new, empty chunk is linked in after chunk (or as the only chunk if chunk is nullptr)
+    // @return  the new chunk
+    Chunk* linkChunkAfter(Chunk* chunk);
+
+    // @post chunk, which holds no items, is unlinked and deleted
+    void unlinkChunk(Chunk* chunk);
+
+    // @post the items of chunk from index on are moved to the end of to, which has room for them
+    void moveTail(Chunk* chunk, int index, Chunk* to);
+
+    // @post an item built from args is inserted at offset in chunk, which is not full
+    template<class... Args>
+    void emplaceInChunk(Chunk* chunk, int offset, Args&&... args);
+}; // end UnrolledList
+
+#include "UnrolledList.cpp"
+#endif